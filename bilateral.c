@@ -0,0 +1,220 @@
+/**
+ * \file bilateral.c
+ * \brief Ce fichier contient le filtre bilatéral par grille bilatérale pour images PGM et PPM.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "bilateral.h"
+#include "ordonnanceur.h"
+#include "pnm.h"
+#include "couleur.h"
+
+/**
+ * \struct Grille_bilaterale
+ * \brief Grille espace x intensité partagée par les tâches
+ *
+ * La case (x, y, z) commence à l'indice ((y * largeur + x) * profondeur + z) * nbr_valeurs:
+ * les sommes des composantes, puis le nombre de pixels.
+ */
+typedef struct {
+    PNM *image;
+    int nbr_canaux, couleur;//couleur: 1 si l'intensité d'une image PPM est sa luminance
+    int nbr_valeurs;//valeurs par case
+    unsigned int valeur_max;
+    double sigma_spatial, sigma_intensite;
+    int largeur, hauteur, profondeur;//dimensions de la grille, marges comprises
+    float *grille, *tampon;
+    int axe;//flou en cours: 0 colonnes, 1 lignes, 2 intensités
+} Grille_bilaterale;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void construit_tranche(int indice, void *contexte);
+static void floute_tranche(int indice, void *contexte);
+static void interpole_tuile(const Tuile *tuile, void *contexte);
+
+
+int filtre_bilateral(PNM *image, double sigma_spatial, double sigma_intensite){
+    assert(image!=NULL && sigma_spatial>=1 && sigma_intensite>=0);
+    Grille_bilaterale grille;
+    int format = acces_format_PNM(image), nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
+    size_t taille;
+    float *echange;
+
+    if(format!=2 && format!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PGM ou PPM pour y appliquer le filtre bilatéral.\n");
+        return -1;
+    }
+    if(nbr_ligne==0 || nbr_colonne==0)
+        return 0;
+
+    grille.image = image;
+    grille.nbr_canaux = acces_nbr_canaux_PNM(image);
+    grille.couleur = (format==3);
+    grille.nbr_valeurs = grille.couleur ? 4 : 2;
+    grille.valeur_max = acces_valeur_max_PNM(image);
+    grille.sigma_spatial = sigma_spatial;
+    grille.sigma_intensite = (sigma_intensite>0) ? sigma_intensite : SIGMA_INTENSITE_BILATERAL * grille.valeur_max;
+    if(grille.sigma_intensite < 1)
+        grille.sigma_intensite = 1;
+
+    //une case par sigma, arrondi au plus proche, et les marges
+    grille.largeur = (int)((nbr_colonne-1) / grille.sigma_spatial + 0.5) + 1 + 2*MARGE_GRILLE_BILATERALE;
+    grille.hauteur = (int)((nbr_ligne-1) / grille.sigma_spatial + 0.5) + 1 + 2*MARGE_GRILLE_BILATERALE;
+    grille.profondeur = (int)(grille.valeur_max / grille.sigma_intensite + 0.5) + 1 + 2*MARGE_GRILLE_BILATERALE;
+    taille = (size_t)grille.largeur * grille.hauteur * grille.profondeur * grille.nbr_valeurs;
+    grille.grille = malloc(taille * sizeof(float));
+    grille.tampon = malloc(taille * sizeof(float));
+    if(grille.grille==NULL || grille.tampon==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        free(grille.grille);
+        free(grille.tampon);
+        return -2;
+    }
+
+    //une tâche par tranche de lignes de la grille: les pixels d'une tranche n'écrivent que dans celle-ci
+    execute_taches(grille.hauteur, construit_tranche, &grille);
+
+    //flou gaussien séparable, d'un tampon à l'autre
+    for(grille.axe=0; grille.axe<3; grille.axe++){
+        execute_taches(grille.hauteur, floute_tranche, &grille);
+        echange = grille.grille;
+        grille.grille = grille.tampon;
+        grille.tampon = echange;
+    }
+
+    execute_tuiles(nbr_ligne, nbr_colonne, grille.nbr_canaux * sizeof(unsigned short), interpole_tuile, &grille);
+
+    free(grille.grille);
+    free(grille.tampon);
+
+    return 0;
+}
+
+static void construit_tranche(int indice, void *contexte){
+    Grille_bilaterale *grille = contexte;
+    int nbr_ligne = acces_nbr_ligne_PNM(grille->image), nbr_colonne = acces_nbr_colonne_PNM(grille->image);
+    int nbr_canaux = grille->nbr_canaux, nbr_valeurs = grille->nbr_valeurs, k = indice - MARGE_GRILLE_BILATERALE;
+    size_t taille_tranche = (size_t)grille->largeur * grille->profondeur * nbr_valeurs;
+    float *tranche = grille->grille + (size_t)indice * taille_tranche, *case_grille;
+    unsigned short *ligne, *pixel;
+    long debut, fin;
+    int x, z;
+
+    memset(tranche, 0, taille_tranche * sizeof(float));
+
+    //lignes i dont la case la plus proche est k: (k - 0.5) sigma <= i < (k + 0.5) sigma
+    debut = (long)ceil((k - 0.5) * grille->sigma_spatial);
+    fin = (long)ceil((k + 0.5) * grille->sigma_spatial);
+    if(debut < 0)
+        debut = 0;
+    if(fin > nbr_ligne)
+        fin = nbr_ligne;
+
+    for(long i=debut; i<fin; i++){
+        ligne = acces_ligne_PNM(grille->image, (int)i);
+        for(int j=0; j<nbr_colonne; j++){
+            pixel = &ligne[j*nbr_canaux];
+            x = (int)(j / grille->sigma_spatial + 0.5) + MARGE_GRILLE_BILATERALE;
+            z = (int)(luminance_pixel(pixel, grille->couleur) / grille->sigma_intensite + 0.5) + MARGE_GRILLE_BILATERALE;
+            case_grille = tranche + ((size_t)x * grille->profondeur + z) * nbr_valeurs;
+            for(int c=0; c<nbr_valeurs-1; c++)
+                case_grille[c] += pixel[c];
+            case_grille[nbr_valeurs-1] += 1;
+        }
+    }
+}
+
+static void floute_tranche(int indice, void *contexte){
+    //gaussienne d'écart type une case, approchée par le noyau binomial 1 4 6 4 1
+    static const float noyau[5] = {1.0f/16, 4.0f/16, 6.0f/16, 4.0f/16, 1.0f/16};
+    Grille_bilaterale *grille = contexte;
+    int largeur = grille->largeur, hauteur = grille->hauteur, profondeur = grille->profondeur, nbr_valeurs = grille->nbr_valeurs;
+    int position[3], limite[3] = {largeur, hauteur, profondeur}, voisin;
+    long pas[3];
+    const float *source;
+    float *destination;
+
+    //écart, en valeurs, entre deux cases voisines le long de chaque axe
+    pas[0] = (long)profondeur * nbr_valeurs;
+    pas[1] = (long)largeur * profondeur * nbr_valeurs;
+    pas[2] = nbr_valeurs;
+
+    position[1] = indice;
+    for(position[0]=0; position[0]<largeur; position[0]++){
+        for(position[2]=0; position[2]<profondeur; position[2]++){
+            source = grille->grille + ((size_t)(indice * largeur + position[0]) * profondeur + position[2]) * nbr_valeurs;
+            destination = grille->tampon + (source - grille->grille);
+            for(int c=0; c<nbr_valeurs; c++)
+                destination[c] = 0;
+            for(int d=-2; d<=2; d++){
+                voisin = position[grille->axe] + d;
+                if(voisin < 0 || voisin >= limite[grille->axe])
+                    continue;
+                for(int c=0; c<nbr_valeurs; c++)
+                    destination[c] += noyau[d+2] * source[d * pas[grille->axe] + c];
+            }
+        }
+    }
+}
+
+static void interpole_tuile(const Tuile *tuile, void *contexte){
+    Grille_bilaterale *grille = contexte;
+    int nbr_canaux = grille->nbr_canaux, nbr_valeurs = grille->nbr_valeurs, profondeur = grille->profondeur;
+    int x0, y0, z0, nbr_composantes = nbr_valeurs - 1;
+    double fx, fy, fz, poids, somme[4], valeur;
+    const float *case_grille;
+    unsigned short *ligne, *pixel;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        fy = i / grille->sigma_spatial + MARGE_GRILLE_BILATERALE;
+        y0 = (int)fy;
+        fy -= y0;
+        ligne = acces_ligne_PNM(grille->image, i);
+
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++){
+            pixel = &ligne[j*nbr_canaux];
+            fx = j / grille->sigma_spatial + MARGE_GRILLE_BILATERALE;
+            x0 = (int)fx;
+            fx -= x0;
+            fz = luminance_pixel(pixel, grille->couleur) / grille->sigma_intensite + MARGE_GRILLE_BILATERALE;
+            z0 = (int)fz;
+            fz -= z0;
+
+            //interpolation trilinéaire des huit cases qui entourent le pixel (les marges évitent tout débordement)
+            for(int c=0; c<nbr_valeurs; c++)
+                somme[c] = 0;
+            for(int coin=0; coin<8; coin++){
+                poids = ((coin & 1) ? fx : 1 - fx) * ((coin & 2) ? fy : 1 - fy) * ((coin & 4) ? fz : 1 - fz);
+                if(poids==0)
+                    continue;
+                case_grille = grille->grille + (((size_t)(y0 + ((coin >> 1) & 1)) * grille->largeur + x0 + (coin & 1)) * profondeur
+                                                + z0 + ((coin >> 2) & 1)) * nbr_valeurs;
+                for(int c=0; c<nbr_valeurs; c++)
+                    somme[c] += poids * case_grille[c];
+            }
+
+            //moyenne pondérée; le pixel contribue toujours à ses cases, le poids total n'est nul qu'en cas d'erreur d'arrondi
+            if(somme[nbr_composantes] <= 0)
+                continue;
+            for(int c=0; c<nbr_composantes; c++){
+                valeur = somme[c] / somme[nbr_composantes] + 0.5;
+                if(valeur > grille->valeur_max)
+                    valeur = grille->valeur_max;
+                pixel[c] = (unsigned short)valeur;
+            }
+        }
+    }
+}
+
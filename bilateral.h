@@ -0,0 +1,59 @@
+/**
+ * \file bilateral.h
+ * \brief Ce fichier contient le prototype du filtre bilatéral par grille bilatérale pour images PGM et PPM.
+ *
+ * L'image est projetée dans une grille espace x intensité sous-échantillonnée
+ * (une case par sigma_spatial pixels et par sigma_intensite niveaux), dont
+ * chaque case accumule la somme des valeurs et le nombre de pixels qui y
+ * tombent. La grille est floutée par un noyau gaussien d'écart type une
+ * case dans les trois dimensions, puis chaque pixel lit par interpolation
+ * trilinéaire la moyenne à sa position et à son intensité. Le coût dépend
+ * de la taille de l'image et de la grille, presque pas de sigma_spatial.
+ * Pour une image PPM, l'intensité est la luminance: les trois composantes
+ * sont lissées avec les mêmes poids, ce qui préserve les contours.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __BILATERAL__
+#define __BILATERAL__
+
+#include "pnm.h"
+
+/**
+ * Écart type en intensité par défaut, en fraction de la valeur max de l'image
+ */
+#define SIGMA_INTENSITE_BILATERAL 0.1
+
+/**
+ * Cases vides ajoutées de chaque côté de la grille, la portée du flou
+ */
+#define MARGE_GRILLE_BILATERALE 2
+
+/**
+ * \fn filtre_bilateral(PNM *image, double sigma_spatial, double sigma_intensite)
+ * \brief Lisse image en préservant les contours (filtre bilatéral approché par grille bilatérale)
+ *
+ * La grille est construite en parallèle, une tâche par tranche de lignes de
+ * la grille; les flous et l'interpolation sont aussi répartis sur les
+ * coeurs.
+ *
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param sigma_spatial l'écart type spatial, en pixels
+ * \param sigma_intensite l'écart type en intensité, en niveaux; 0 pour SIGMA_INTENSITE_BILATERAL fois la valeur max
+ *
+ * \pre image!=NULL, sigma_spatial>=1, sigma_intensite>=0
+ * \post valeurs du tableau de pixel modifiées
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pgm ou ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ *
+ */
+int filtre_bilateral(PNM *image, double sigma_spatial, double sigma_intensite);
+
+#endif
@@ -0,0 +1,399 @@
+/**
+ * \file cache.c
+ * \brief Ce fichier contient le cache de résultats sur disque, adressé par le contenu.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "cache.h"
+#include "pnm.h"
+#include "compression.h"
+
+/**
+ * Taille des blocs lus pour l'empreinte du fichier input et pour les copies
+ */
+#define TAILLE_BLOC (1 << 20)
+
+/**
+ * Constantes premières de xxHash64
+ */
+#define PREMIER_1 11400714785074694791ULL
+#define PREMIER_2 14029467366897019727ULL
+#define PREMIER_3 1609587929392839161ULL
+#define PREMIER_4 9650029242287828579ULL
+#define PREMIER_5 2870177450012600261ULL
+
+/**
+ * \struct Etat_xxh64
+ * \brief État d'un calcul d'empreinte xxHash64 sur des données reçues par morceaux
+ */
+typedef struct {
+    uint64_t accumulateurs[4];
+    unsigned char reste[32];//octets en attente d'une bande complète de 32 octets
+    size_t taille_reste;
+    uint64_t longueur, graine;
+} Etat_xxh64;
+
+/**
+ * \struct Entree_cache
+ * \brief Fichier d'entrée du cache, avec sa date de dernière utilisation et sa taille
+ */
+typedef struct {
+    char nom[TAILLE_CLE_CACHE + 4];
+    struct timespec date;
+    unsigned long taille;
+} Entree_cache;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void debut_xxh64(Etat_xxh64 *etat, uint64_t graine);
+static void ajoute_xxh64(Etat_xxh64 *etat, const unsigned char *donnees, size_t taille);
+static uint64_t fin_xxh64(Etat_xxh64 *etat);
+static inline uint64_t lit_64(const unsigned char *octets);
+static inline uint64_t lit_32(const unsigned char *octets);
+static inline uint64_t rotation(uint64_t valeur, int bits);
+static inline uint64_t tour_xxh64(uint64_t accumulateur, uint64_t valeur);
+static void ajoute_chaine_xxh64(Etat_xxh64 *etat, const char *chaine);
+static char *chemin_cache(char *repertoire, const char *nom);
+static int copie_fichier(FILE *source, FILE *destination);
+static void reduit_cache(char *repertoire, unsigned long taille_max);
+static int compare_entrees(const void *a, const void *b);
+
+
+int cle_cache(char cle[TAILLE_CLE_CACHE], char *filename, char *filtre, char *parametre, char *roi){
+    assert(cle!=NULL && filename!=NULL && filtre!=NULL);
+    Etat_xxh64 etat;
+    uint64_t empreinte_fichier;
+    unsigned char *bloc;
+    size_t lus;
+    FILE *fichier;
+
+    fichier = fopen(filename, "rb");
+    if(fichier==NULL)
+        return -1;
+    bloc = malloc(TAILLE_BLOC);
+    if(bloc==NULL){
+        fclose(fichier);
+        return -1;
+    }
+
+    debut_xxh64(&etat, 0);
+    while((lus = fread(bloc, 1, TAILLE_BLOC, fichier)) > 0)
+        ajoute_xxh64(&etat, bloc, lus);
+    free(bloc);
+    if(ferror(fichier)){
+        fclose(fichier);
+        return -1;
+    }
+    fclose(fichier);
+    empreinte_fichier = fin_xxh64(&etat);
+
+    //la chaîne de filtres est hachée avec l'empreinte du fichier comme graine
+    debut_xxh64(&etat, empreinte_fichier);
+    ajoute_chaine_xxh64(&etat, filtre);
+    ajoute_chaine_xxh64(&etat, parametre);
+    ajoute_chaine_xxh64(&etat, roi);
+
+    sprintf(cle, "%016llx%016llx", (unsigned long long)empreinte_fichier, (unsigned long long)fin_xxh64(&etat));
+    return 0;
+}
+
+int cherche_cache(char *repertoire, const char *cle, char *filename_output){
+    assert(repertoire!=NULL && cle!=NULL && filename_output!=NULL);
+    char nom[TAILLE_CLE_CACHE + 4];
+    char *chemin;
+    FILE *entree, *destination;
+    int format, resultat = 0;
+
+    sprintf(nom, "%s.pnm", cle);
+    chemin = chemin_cache(repertoire, nom);
+    if(chemin==NULL)
+        return -1;
+    entree = fopen(chemin, "rb");
+    if(entree==NULL){
+        free(chemin);
+        return -1;
+    }
+
+    if(verifie_nombre_magique(&format, entree)!=0)
+        resultat = -1;
+    else if(verifie_validite_filename(filename_output)!=0 || adapte_extension_format(filename_output, format)!=0)
+        resultat = -2;
+    else{
+        //l'entrée est une image non compressée: elle est compressée si filename_output se termine par ".gz"
+        rewind(entree);
+        destination = ouvre_fichier_image(filename_output, "w");
+        if(destination==NULL)
+            resultat = -2;
+        else{
+            if(copie_fichier(entree, destination)!=0)
+                resultat = -2;
+            if(ferme_fichier_image(destination)!=0)
+                resultat = -2;
+        }
+    }
+    fclose(entree);
+
+    //l'entrée devient la plus récemment utilisée
+    if(resultat==0)
+        utimensat(AT_FDCWD, chemin, NULL, 0);
+    free(chemin);
+    return resultat;
+}
+
+int ajoute_cache(char *repertoire, const char *cle, char *filename_output, unsigned long taille_max){
+    assert(repertoire!=NULL && cle!=NULL && filename_output!=NULL);
+    char nom[TAILLE_CLE_CACHE + 4], nom_temporaire[TAILLE_CLE_CACHE + 32];
+    char *chemin, *chemin_temporaire;
+    FILE *source, *temporaire = NULL;
+    int resultat = 0;
+
+    if(mkdir(repertoire, 0777)!=0 && errno!=EEXIST)
+        return -1;
+
+    sprintf(nom, "%s.pnm", cle);
+    sprintf(nom_temporaire, ".%s.%ld.tmp", cle, (long)getpid());
+    chemin = chemin_cache(repertoire, nom);
+    chemin_temporaire = chemin_cache(repertoire, nom_temporaire);
+    //les entrées sont toujours enregistrées non compressées: un output ".gz" est décompressé
+    source = ouvre_fichier_image(filename_output, "r");
+    if(chemin==NULL || chemin_temporaire==NULL || source==NULL)
+        resultat = -1;
+
+    //écriture complète sous un nom temporaire, puis renommage atomique une fois la décompression terminée sans erreur
+    if(resultat==0){
+        temporaire = fopen(chemin_temporaire, "wb");
+        if(temporaire==NULL || copie_fichier(source, temporaire)!=0)
+            resultat = -1;
+        if(temporaire!=NULL && fclose(temporaire)!=0)
+            resultat = -1;
+    }
+    if(source!=NULL && ferme_fichier_image(source)!=0)
+        resultat = -1;
+    if(temporaire!=NULL && (resultat!=0 || rename(chemin_temporaire, chemin)!=0)){
+        remove(chemin_temporaire);
+        resultat = -1;
+    }
+
+    free(chemin);
+    free(chemin_temporaire);
+
+    if(resultat==0)
+        reduit_cache(repertoire, taille_max);
+    return resultat;
+}
+
+static void reduit_cache(char *repertoire, unsigned long taille_max){
+    Entree_cache *entrees = NULL, *agrandi;
+    size_t nbr_entrees = 0, capacite = 0, longueur;
+    unsigned long total = 0;
+    struct dirent *element;
+    struct stat informations;
+    char *chemin;
+    DIR *dossier;
+
+    dossier = opendir(repertoire);
+    if(dossier==NULL)
+        return;
+
+    while((element = readdir(dossier))!=NULL){
+        longueur = strlen(element->d_name);
+        if(longueur!=TAILLE_CLE_CACHE-1+4 || strcmp(element->d_name + longueur - 4, ".pnm")!=0)
+            continue;
+        chemin = chemin_cache(repertoire, element->d_name);
+        //une entrée supprimée entre-temps par une exécution concurrente est ignorée
+        if(chemin==NULL || stat(chemin, &informations)!=0){
+            free(chemin);
+            continue;
+        }
+        free(chemin);
+
+        if(nbr_entrees==capacite){
+            capacite = capacite ? 2*capacite : 64;
+            agrandi = realloc(entrees, capacite * sizeof(Entree_cache));
+            if(agrandi==NULL)
+                break;
+            entrees = agrandi;
+        }
+        strcpy(entrees[nbr_entrees].nom, element->d_name);
+        entrees[nbr_entrees].date = informations.st_mtim;
+        entrees[nbr_entrees].taille = (unsigned long)informations.st_size;
+        total += entrees[nbr_entrees].taille;
+        nbr_entrees++;
+    }
+    closedir(dossier);
+
+    //suppression des entrées les moins récemment utilisées jusqu'à respecter la borne
+    if(total > taille_max){
+        qsort(entrees, nbr_entrees, sizeof(Entree_cache), compare_entrees);
+        for(size_t k=0; k<nbr_entrees && total>taille_max; k++){
+            chemin = chemin_cache(repertoire, entrees[k].nom);
+            if(chemin!=NULL)
+                remove(chemin);
+            free(chemin);
+            total -= entrees[k].taille;
+        }
+    }
+    free(entrees);
+}
+
+static int compare_entrees(const void *a, const void *b){
+    const Entree_cache *premiere = a, *seconde = b;
+
+    if(premiere->date.tv_sec != seconde->date.tv_sec)
+        return premiere->date.tv_sec < seconde->date.tv_sec ? -1 : 1;
+    if(premiere->date.tv_nsec != seconde->date.tv_nsec)
+        return premiere->date.tv_nsec < seconde->date.tv_nsec ? -1 : 1;
+    return strcmp(premiere->nom, seconde->nom);
+}
+
+static char *chemin_cache(char *repertoire, const char *nom){
+    char *chemin = malloc(strlen(repertoire) + strlen(nom) + 2);
+
+    if(chemin!=NULL)
+        sprintf(chemin, "%s/%s", repertoire, nom);
+    return chemin;
+}
+
+static int copie_fichier(FILE *source, FILE *destination){
+    unsigned char *bloc;
+    size_t lus;
+    int resultat = 0;
+
+    bloc = malloc(TAILLE_BLOC);
+    if(bloc==NULL)
+        return -1;
+
+    while(resultat==0 && (lus = fread(bloc, 1, TAILLE_BLOC, source)) > 0)
+        if(fwrite(bloc, 1, lus, destination)!=lus)
+            resultat = -1;
+    if(ferror(source))
+        resultat = -1;
+
+    free(bloc);
+    return resultat;
+}
+
+static void ajoute_chaine_xxh64(Etat_xxh64 *etat, const char *chaine){
+    //un octet de présence distingue une chaîne absente d'une chaîne vide
+    unsigned char present = (chaine!=NULL);
+
+    ajoute_xxh64(etat, &present, 1);
+    if(chaine!=NULL)
+        ajoute_xxh64(etat, (const unsigned char *)chaine, strlen(chaine) + 1);
+}
+
+static void debut_xxh64(Etat_xxh64 *etat, uint64_t graine){
+    etat->graine = graine;
+    etat->accumulateurs[0] = graine + PREMIER_1 + PREMIER_2;
+    etat->accumulateurs[1] = graine + PREMIER_2;
+    etat->accumulateurs[2] = graine;
+    etat->accumulateurs[3] = graine - PREMIER_1;
+    etat->taille_reste = 0;
+    etat->longueur = 0;
+}
+
+static void ajoute_xxh64(Etat_xxh64 *etat, const unsigned char *donnees, size_t taille){
+    size_t complement;
+
+    etat->longueur += taille;
+
+    //complétion de la bande en attente
+    if(etat->taille_reste > 0){
+        complement = 32 - etat->taille_reste;
+        if(complement > taille)
+            complement = taille;
+        memcpy(etat->reste + etat->taille_reste, donnees, complement);
+        etat->taille_reste += complement;
+        donnees += complement;
+        taille -= complement;
+        if(etat->taille_reste < 32)
+            return;
+        for(int k=0; k<4; k++)
+            etat->accumulateurs[k] = tour_xxh64(etat->accumulateurs[k], lit_64(etat->reste + 8*k));
+        etat->taille_reste = 0;
+    }
+
+    //bandes de 32 octets: quatre accumulateurs indépendants
+    for(; taille >= 32; donnees += 32, taille -= 32)
+        for(int k=0; k<4; k++)
+            etat->accumulateurs[k] = tour_xxh64(etat->accumulateurs[k], lit_64(donnees + 8*k));
+
+    memcpy(etat->reste, donnees, taille);
+    etat->taille_reste = taille;
+}
+
+static uint64_t fin_xxh64(Etat_xxh64 *etat){
+    const unsigned char *octets = etat->reste;
+    size_t taille = etat->taille_reste;
+    uint64_t empreinte;
+
+    if(etat->longueur >= 32){
+        empreinte = rotation(etat->accumulateurs[0], 1) + rotation(etat->accumulateurs[1], 7) +
+                    rotation(etat->accumulateurs[2], 12) + rotation(etat->accumulateurs[3], 18);
+        for(int k=0; k<4; k++){
+            empreinte ^= tour_xxh64(0, etat->accumulateurs[k]);
+            empreinte = empreinte * PREMIER_1 + PREMIER_4;
+        }
+    }
+    else
+        empreinte = etat->graine + PREMIER_5;
+    empreinte += etat->longueur;
+
+    for(; taille >= 8; octets += 8, taille -= 8){
+        empreinte ^= tour_xxh64(0, lit_64(octets));
+        empreinte = rotation(empreinte, 27) * PREMIER_1 + PREMIER_4;
+    }
+    if(taille >= 4){
+        empreinte ^= lit_32(octets) * PREMIER_1;
+        empreinte = rotation(empreinte, 23) * PREMIER_2 + PREMIER_3;
+        octets += 4;
+        taille -= 4;
+    }
+    for(; taille > 0; octets++, taille--){
+        empreinte ^= *octets * PREMIER_5;
+        empreinte = rotation(empreinte, 11) * PREMIER_1;
+    }
+
+    empreinte ^= empreinte >> 33;
+    empreinte *= PREMIER_2;
+    empreinte ^= empreinte >> 29;
+    empreinte *= PREMIER_3;
+    empreinte ^= empreinte >> 32;
+    return empreinte;
+}
+
+static inline uint64_t tour_xxh64(uint64_t accumulateur, uint64_t valeur){
+    accumulateur += valeur * PREMIER_2;
+    return rotation(accumulateur, 31) * PREMIER_1;
+}
+
+static inline uint64_t rotation(uint64_t valeur, int bits){
+    return (valeur << bits) | (valeur >> (64 - bits));
+}
+
+static inline uint64_t lit_64(const unsigned char *octets){
+    //lecture petit-boutiste, indépendante de la machine
+    return lit_32(octets) | (lit_32(octets + 4) << 32);
+}
+
+static inline uint64_t lit_32(const unsigned char *octets){
+    return (uint64_t)octets[0] | ((uint64_t)octets[1] << 8) | ((uint64_t)octets[2] << 16) | ((uint64_t)octets[3] << 24);
+}
@@ -0,0 +1,97 @@
+/**
+ * \file cache.h
+ * \brief Ce fichier contient les déclarations du cache de résultats sur disque, adressé par le contenu.
+ *
+ * Une entrée du cache est l'image output d'une exécution, enregistrée non
+ * compressée sous <répertoire>/<clé>.pnm. La clé est formée de l'empreinte (xxHash64) du
+ * fichier input et de celle du filtre, du paramètre et de la région
+ * d'intérêt. La date de modification d'une entrée est mise à jour à chaque
+ * utilisation: les entrées les moins récemment utilisées sont supprimées
+ * lorsque la taille du répertoire dépasse la borne donnée.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __CACHE__
+#define __CACHE__
+
+/**
+ * Taille d'une clé de cache: 32 chiffres hexadécimaux et le caractère nul
+ */
+#define TAILLE_CLE_CACHE 33
+
+/**
+ * Taille maximale par défaut du répertoire de cache, en octets
+ */
+#define TAILLE_CACHE_DEFAUT (256UL << 20)
+
+/**
+ * \fn cle_cache(char cle[TAILLE_CLE_CACHE], char *filename, char *filtre, char *parametre, char *roi)
+ * \brief Calcule la clé d'une exécution à partir du contenu du fichier input et de la chaîne de filtres
+ *
+ * \param cle chaine recevant la clé
+ * \param filename le fichier input, lu par blocs sans être interprété
+ * \param filtre le nom du filtre
+ * \param parametre le paramètre du filtre, NULL si absent
+ * \param roi la région d'intérêt, NULL si absente
+ *
+ * \pre cle!=NULL, filename!=NULL, filtre!=NULL
+ * \post cle contient 32 chiffres hexadécimaux
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Lecture du fichier input impossible
+ *
+ */
+int cle_cache(char cle[TAILLE_CLE_CACHE], char *filename, char *filtre, char *parametre, char *roi);
+
+/**
+ * \fn cherche_cache(char *repertoire, const char *cle, char *filename_output)
+ * \brief Copie l'entrée de clé donnée, si elle existe, dans filename_output
+ *
+ * L'extension de filename_output est adaptée au format de l'entrée, comme
+ * le fait verifie_extension_fichier pour une image calculée. L'entrée est
+ * compressée si filename_output se termine par ".gz".
+ *
+ * \param repertoire le répertoire de cache
+ * \param cle la clé de l'exécution
+ * \param filename_output le nom de l'image output
+ *
+ * \pre repertoire!=NULL, cle!=NULL, filename_output!=NULL
+ * \post en cas de succès, filename_output contient le résultat enregistré et l'entrée est marquée comme utilisée
+ *
+ * \return
+ *       0 Entrée trouvée et copiée \n
+ *      -1 Aucune entrée pour cette clé \n
+ *      -2 Nom ou extension de filename_output incorrect, ou écriture impossible
+ *
+ */
+int cherche_cache(char *repertoire, const char *cle, char *filename_output);
+
+/**
+ * \fn ajoute_cache(char *repertoire, const char *cle, char *filename_output, unsigned long taille_max)
+ * \brief Enregistre filename_output comme entrée de clé donnée, puis réduit le cache à taille_max octets
+ *
+ * L'entrée est écrite dans un fichier temporaire propre au processus puis
+ * renommée: des exécutions concurrentes ne voient jamais d'entrée partielle.
+ * Un filename_output compressé (".gz") est décompressé dans l'entrée.
+ *
+ * \param repertoire le répertoire de cache, créé s'il n'existe pas
+ * \param cle la clé de l'exécution
+ * \param filename_output l'image output à enregistrer
+ * \param taille_max la taille maximale du répertoire de cache, en octets
+ *
+ * \pre repertoire!=NULL, cle!=NULL, filename_output!=NULL
+ * \post l'entrée est présente dans le cache, sauf si elle dépasse à elle seule taille_max
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Écriture de l'entrée impossible
+ *
+ */
+int ajoute_cache(char *repertoire, const char *cle, char *filename_output, unsigned long taille_max);
+
+#endif
@@ -0,0 +1,342 @@
+/**
+ * \file comparaison.c
+ * \brief Ce fichier contient la comparaison de deux images PNM (écart maximal, EQM, PSNR, SSIM).
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "comparaison.h"
+#include "pnm.h"
+
+/**
+ * Côté des fenêtres SSIM et espacement entre deux fenêtres voisines
+ */
+#define COTE_FENETRE 8
+#define PAS_FENETRE 4
+
+/**
+ * Nombre minimal de lignes d'une bande traitée par un thread
+ */
+#define HAUTEUR_MIN_BANDE 32
+
+/**
+ * \struct Bande_comparaison
+ * \brief Lignes [premiere_ligne, derniere_ligne[ et rangées de fenêtres [premiere_rangee, derniere_rangee[ comparées par un thread
+ */
+typedef struct {
+    PNM *image1, *image2;
+    int nbr_composantes, hauteur_fenetre, largeur_fenetre;
+    int premiere_ligne, derniere_ligne;
+    int premiere_rangee, derniere_rangee;
+    unsigned long long somme_carres[3];
+    unsigned int ecart_max[3];
+    double somme_ssim[3];
+    int erreur;
+} Bande_comparaison;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void *compare_bande(void *arg);
+static void compare_lignes(Bande_comparaison *bande);
+static void compare_ligne_1(const unsigned short *restrict ligne1, const unsigned short *restrict ligne2, int nbr_colonne,
+                            unsigned long long somme[3], unsigned int ecart[3]);
+static void compare_ligne_3(const unsigned short *restrict ligne1, const unsigned short *restrict ligne2, int nbr_colonne,
+                            unsigned long long somme[3], unsigned int ecart[3]);
+static void compare_ligne_pas(const unsigned short *ligne1, const unsigned short *ligne2, int nbr_colonne, int canaux1, int canaux2,
+                              int nbr_composantes, unsigned long long somme[3], unsigned int ecart[3]);
+static void cumule_colonnes(const unsigned short *restrict ligne1, const unsigned short *restrict ligne2, int nbr_valeurs,
+                            uint32_t *restrict s1, uint32_t *restrict s2, uint32_t *restrict s11, uint32_t *restrict s22, uint32_t *restrict s12);
+static int ssim_rangees(Bande_comparaison *bande);
+static double psnr(double eqm, unsigned int valeur_max);
+
+
+int compare_PNM(PNM *image1, PNM *image2, Comparaison_PNM *comparaison){
+    assert(image1!=NULL && image2!=NULL && comparaison!=NULL);
+    int nbr_ligne = acces_nbr_ligne_PNM(image1), nbr_colonne = acces_nbr_colonne_PNM(image1);
+    int format = acces_format_PNM(image1), nbr_composantes = (format==3) ? 3 : 1;
+    unsigned int valeur_max = acces_valeur_max_PNM(image1);
+    Bande_comparaison bandes[NBR_MAX_THREADS];
+    pthread_t threads[NBR_MAX_THREADS];
+    int lance[NBR_MAX_THREADS];
+    int hauteur_fenetre, largeur_fenetre, nbr_rangees, nbr_bandes, erreur = 0;
+    unsigned long long somme_carres, total_carres = 0;
+    double somme_ssim;
+    long nbr_fenetres;
+
+    if(acces_format_PNM(image2)!=format || acces_nbr_ligne_PNM(image2)!=nbr_ligne ||
+       acces_nbr_colonne_PNM(image2)!=nbr_colonne || acces_valeur_max_PNM(image2)!=valeur_max){
+        printf("Les images comparées doivent avoir le même format, les mêmes dimensions et la même valeur maximale.\n");
+        return -1;
+    }
+
+    //une image plus petite qu'une fenêtre est comparée en une seule fenêtre
+    hauteur_fenetre = nbr_ligne < COTE_FENETRE ? nbr_ligne : COTE_FENETRE;
+    largeur_fenetre = nbr_colonne < COTE_FENETRE ? nbr_colonne : COTE_FENETRE;
+    nbr_rangees = (nbr_ligne - hauteur_fenetre) / PAS_FENETRE + 1;
+    nbr_fenetres = (long)nbr_rangees * ((nbr_colonne - largeur_fenetre) / PAS_FENETRE + 1);
+
+    nbr_bandes = nombre_threads_disponibles();
+    if(nbr_bandes > nbr_ligne / HAUTEUR_MIN_BANDE)
+        nbr_bandes = nbr_ligne / HAUTEUR_MIN_BANDE;
+    if(nbr_bandes < 1)
+        nbr_bandes = 1;
+
+    for(int b=0; b<nbr_bandes; b++){
+        bandes[b].image1 = image1;
+        bandes[b].image2 = image2;
+        bandes[b].nbr_composantes = nbr_composantes;
+        bandes[b].hauteur_fenetre = hauteur_fenetre;
+        bandes[b].largeur_fenetre = largeur_fenetre;
+        bandes[b].premiere_ligne = (int)((long)nbr_ligne * b / nbr_bandes);
+        bandes[b].derniere_ligne = (int)((long)nbr_ligne * (b+1) / nbr_bandes);
+        bandes[b].premiere_rangee = (int)((long)nbr_rangees * b / nbr_bandes);
+        bandes[b].derniere_rangee = (int)((long)nbr_rangees * (b+1) / nbr_bandes);
+        bandes[b].erreur = 0;
+        lance[b] = (pthread_create(&threads[b], NULL, compare_bande, &bandes[b])==0);
+        if(!lance[b])
+            compare_bande(&bandes[b]);
+    }
+    for(int b=0; b<nbr_bandes; b++){
+        if(lance[b])
+            pthread_join(threads[b], NULL);
+        if(bandes[b].erreur)
+            erreur = 1;
+    }
+    if(erreur){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+
+    comparaison->nbr_composantes = nbr_composantes;
+    comparaison->ecart_max_global = 0;
+    comparaison->ssim_global = 0;
+    for(int x=0; x<nbr_composantes; x++){
+        comparaison->ecart_max[x] = 0;
+        somme_carres = 0;
+        somme_ssim = 0;
+        for(int b=0; b<nbr_bandes; b++){
+            if(bandes[b].ecart_max[x] > comparaison->ecart_max[x])
+                comparaison->ecart_max[x] = bandes[b].ecart_max[x];
+            somme_carres += bandes[b].somme_carres[x];
+            somme_ssim += bandes[b].somme_ssim[x];
+        }
+        total_carres += somme_carres;
+        comparaison->eqm[x] = (double)somme_carres / ((double)nbr_ligne * nbr_colonne);
+        comparaison->psnr[x] = psnr(comparaison->eqm[x], valeur_max);
+        comparaison->ssim[x] = somme_ssim / nbr_fenetres;
+        if(comparaison->ecart_max[x] > comparaison->ecart_max_global)
+            comparaison->ecart_max_global = comparaison->ecart_max[x];
+        comparaison->ssim_global += comparaison->ssim[x] / nbr_composantes;
+    }
+    comparaison->eqm_global = (double)total_carres / ((double)nbr_ligne * nbr_colonne * nbr_composantes);
+    comparaison->psnr_global = psnr(comparaison->eqm_global, valeur_max);
+
+    return 0;
+}
+
+void affiche_comparaison(const Comparaison_PNM *comparaison){
+    assert(comparaison!=NULL);
+    const char *noms[3] = {"r", "v", "b"};
+
+    printf("composante ecart_max EQM PSNR SSIM\n");
+    for(int x=0; x<comparaison->nbr_composantes; x++)
+        printf("%s %u %.6f %.4f %.6f\n", comparaison->nbr_composantes==3 ? noms[x] : "gris", comparaison->ecart_max[x],
+               comparaison->eqm[x], comparaison->psnr[x], comparaison->ssim[x]);
+    printf("global %u %.6f %.4f %.6f\n", comparaison->ecart_max_global, comparaison->eqm_global,
+           comparaison->psnr_global, comparaison->ssim_global);
+}
+
+static void *compare_bande(void *arg){
+    Bande_comparaison *bande = arg;
+
+    compare_lignes(bande);
+    if(ssim_rangees(bande)!=0)
+        bande->erreur = 1;
+    return NULL;
+}
+
+static void compare_lignes(Bande_comparaison *bande){
+    int nbr_colonne = acces_nbr_colonne_PNM(bande->image1), nbr_composantes = bande->nbr_composantes;
+    int canaux1 = acces_nbr_canaux_PNM(bande->image1), canaux2 = acces_nbr_canaux_PNM(bande->image2);
+    unsigned short *ligne1, *ligne2;
+
+    for(int x=0; x<3; x++){
+        bande->somme_carres[x] = 0;
+        bande->ecart_max[x] = 0;
+    }
+
+    //un seul passage par ligne pour toutes les composantes; pas quelconque si une image garde des canaux inutilisés (après gris)
+    for(int i=bande->premiere_ligne; i<bande->derniere_ligne; i++){
+        ligne1 = acces_ligne_PNM(bande->image1, i);
+        ligne2 = acces_ligne_PNM(bande->image2, i);
+        if(canaux1!=nbr_composantes || canaux2!=nbr_composantes)
+            compare_ligne_pas(ligne1, ligne2, nbr_colonne, canaux1, canaux2, nbr_composantes, bande->somme_carres, bande->ecart_max);
+        else if(nbr_composantes==3)
+            compare_ligne_3(ligne1, ligne2, nbr_colonne, bande->somme_carres, bande->ecart_max);
+        else
+            compare_ligne_1(ligne1, ligne2, nbr_colonne, bande->somme_carres, bande->ecart_max);
+    }
+}
+
+//valeur_max <= 255: un carré tient sur 32 bits, les sommes d'une ligne sur 64 bits
+static void compare_ligne_1(const unsigned short *restrict ligne1, const unsigned short *restrict ligne2, int nbr_colonne,
+                            unsigned long long somme[3], unsigned int ecart[3]){
+    unsigned long long s = 0;
+    unsigned int e = 0, ecart_valeur;
+    int difference;
+
+    for(int j=0; j<nbr_colonne; j++){
+        difference = (int)ligne1[j] - (int)ligne2[j];
+        ecart_valeur = (unsigned int)(difference < 0 ? -difference : difference);
+        s += ecart_valeur * ecart_valeur;
+        e = ecart_valeur > e ? ecart_valeur : e;
+    }
+    somme[0] += s;
+    ecart[0] = e > ecart[0] ? e : ecart[0];
+}
+
+NOYAU_VECTORIEL
+static void compare_ligne_3(const unsigned short *restrict ligne1, const unsigned short *restrict ligne2, int nbr_colonne,
+                            unsigned long long somme[3], unsigned int ecart[3]){
+    unsigned long long s0 = 0, s1 = 0, s2 = 0;
+    unsigned int e0 = 0, e1 = 0, e2 = 0, d0, d1, d2;
+
+    for(int j=0; j<nbr_colonne; j++){
+        d0 = (unsigned int)abs((int)ligne1[3*j] - (int)ligne2[3*j]);
+        d1 = (unsigned int)abs((int)ligne1[3*j+1] - (int)ligne2[3*j+1]);
+        d2 = (unsigned int)abs((int)ligne1[3*j+2] - (int)ligne2[3*j+2]);
+        s0 += d0 * d0;
+        s1 += d1 * d1;
+        s2 += d2 * d2;
+        e0 = d0 > e0 ? d0 : e0;
+        e1 = d1 > e1 ? d1 : e1;
+        e2 = d2 > e2 ? d2 : e2;
+    }
+    somme[0] += s0;
+    somme[1] += s1;
+    somme[2] += s2;
+    ecart[0] = e0 > ecart[0] ? e0 : ecart[0];
+    ecart[1] = e1 > ecart[1] ? e1 : ecart[1];
+    ecart[2] = e2 > ecart[2] ? e2 : ecart[2];
+}
+
+static void compare_ligne_pas(const unsigned short *ligne1, const unsigned short *ligne2, int nbr_colonne, int canaux1, int canaux2,
+                              int nbr_composantes, unsigned long long somme[3], unsigned int ecart[3]){
+    unsigned int ecart_valeur;
+
+    for(int x=0; x<nbr_composantes; x++){
+        for(int j=0; j<nbr_colonne; j++){
+            ecart_valeur = (unsigned int)abs((int)ligne1[j*canaux1+x] - (int)ligne2[j*canaux2+x]);
+            somme[x] += ecart_valeur * ecart_valeur;
+            if(ecart_valeur > ecart[x])
+                ecart[x] = ecart_valeur;
+        }
+    }
+}
+
+//passage contigu sur toutes les valeurs de la ligne, composantes entrelacées comprises
+static void cumule_colonnes(const unsigned short *restrict ligne1, const unsigned short *restrict ligne2, int nbr_valeurs,
+                            uint32_t *restrict s1, uint32_t *restrict s2, uint32_t *restrict s11, uint32_t *restrict s22, uint32_t *restrict s12){
+    uint32_t a, b;
+
+    for(int k=0; k<nbr_valeurs; k++){
+        a = ligne1[k];
+        b = ligne2[k];
+        s1[k] += a;
+        s2[k] += b;
+        s11[k] += a*a;
+        s22[k] += b*b;
+        s12[k] += a*b;
+    }
+}
+
+static int ssim_rangees(Bande_comparaison *bande){
+    int nbr_colonne = acces_nbr_colonne_PNM(bande->image1), nbr_composantes = bande->nbr_composantes;
+    int canaux1 = acces_nbr_canaux_PNM(bande->image1), canaux2 = acces_nbr_canaux_PNM(bande->image2);
+    int nbr_valeurs = nbr_colonne * nbr_composantes;
+    unsigned short *ligne1, *ligne2;
+    uint32_t a, b;
+    int hauteur = bande->hauteur_fenetre, largeur = bande->largeur_fenetre;
+    double n = (double)hauteur * largeur, valeur_max = acces_valeur_max_PNM(bande->image1);
+    double c1 = (0.01*valeur_max) * (0.01*valeur_max), c2 = (0.03*valeur_max) * (0.03*valeur_max);
+    double moyenne1, moyenne2, variance1, variance2, covariance;
+    uint32_t *colonnes, *s1, *s2, *s11, *s22, *s12;
+    uint64_t f1, f2, f11, f22, f12;
+
+    /*sommes par composante de chaque colonne (indice j*nbr_composantes+x) sur la hauteur d'une fenêtre: valeurs, carrés et
+    produits des deux images; avec valeur_max <= 255, au plus COTE_FENETRE * 255 * 255 par somme*/
+    colonnes = malloc((size_t)5 * nbr_valeurs * sizeof(uint32_t));
+    if(colonnes==NULL)
+        return -1;
+    s1 = colonnes;
+    s2 = s1 + nbr_valeurs;
+    s11 = s2 + nbr_valeurs;
+    s22 = s11 + nbr_valeurs;
+    s12 = s22 + nbr_valeurs;
+
+    for(int x=0; x<nbr_composantes; x++)
+        bande->somme_ssim[x] = 0;
+    for(int r=bande->premiere_rangee; r<bande->derniere_rangee; r++){
+        memset(colonnes, 0, (size_t)5 * nbr_valeurs * sizeof(uint32_t));
+        for(int i=r*PAS_FENETRE; i<r*PAS_FENETRE+hauteur; i++){
+            ligne1 = acces_ligne_PNM(bande->image1, i);
+            ligne2 = acces_ligne_PNM(bande->image2, i);
+            if(canaux1==nbr_composantes && canaux2==nbr_composantes){
+                cumule_colonnes(ligne1, ligne2, nbr_valeurs, s1, s2, s11, s22, s12);
+                continue;
+            }
+            for(int k=0; k<nbr_valeurs; k++){
+                a = ligne1[(k / nbr_composantes) * canaux1 + k % nbr_composantes];
+                b = ligne2[(k / nbr_composantes) * canaux2 + k % nbr_composantes];
+                s1[k] += a;
+                s2[k] += b;
+                s11[k] += a*a;
+                s22[k] += b*b;
+                s12[k] += a*b;
+            }
+        }
+
+        for(int x=0; x<nbr_composantes; x++){
+            for(int c=0; c+largeur<=nbr_colonne; c+=PAS_FENETRE){
+                f1 = f2 = f11 = f22 = f12 = 0;
+                for(int k=c*nbr_composantes+x; k<(c+largeur)*nbr_composantes; k+=nbr_composantes){
+                    f1 += s1[k];
+                    f2 += s2[k];
+                    f11 += s11[k];
+                    f22 += s22[k];
+                    f12 += s12[k];
+                }
+                moyenne1 = f1 / n;
+                moyenne2 = f2 / n;
+                variance1 = f11 / n - moyenne1*moyenne1;
+                variance2 = f22 / n - moyenne2*moyenne2;
+                covariance = f12 / n - moyenne1*moyenne2;
+                bande->somme_ssim[x] += ((2*moyenne1*moyenne2 + c1) * (2*covariance + c2)) /
+                                        ((moyenne1*moyenne1 + moyenne2*moyenne2 + c1) * (variance1 + variance2 + c2));
+            }
+        }
+    }
+
+    free(colonnes);
+    return 0;
+}
+
+static double psnr(double eqm, unsigned int valeur_max){
+    if(eqm==0)
+        return INFINITY;
+    return 10 * log10((double)valeur_max * valeur_max / eqm);
+}
@@ -0,0 +1,65 @@
+/**
+ * \file comparaison.h
+ * \brief Ce fichier contient les déclarations de la comparaison de deux images PNM (écart maximal, EQM, PSNR, SSIM).
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __COMPARAISON__
+#define __COMPARAISON__
+
+#include "pnm.h"
+
+/**
+ * \struct Comparaison_PNM
+ * \brief Mesures de différence entre deux images, par composante (r, v, b ou gris) et globales
+ */
+typedef struct {
+    int nbr_composantes;
+    unsigned int ecart_max[3], ecart_max_global;//plus grande différence absolue
+    double eqm[3], eqm_global;//erreur quadratique moyenne
+    double psnr[3], psnr_global;//en dB, infini pour des images identiques
+    double ssim[3], ssim_global;//moyenne des SSIM de fenêtres 8x8 espacées de 4 pixels
+} Comparaison_PNM;
+
+/**
+ * \fn compare_PNM(PNM *image1, PNM *image2, Comparaison_PNM *comparaison)
+ * \brief Compare deux images de même format, mêmes dimensions et même valeur maximale
+ *
+ * Les lignes sont réparties en bandes traitées en parallèle. Pour la SSIM,
+ * les sommes des valeurs, de leurs carrés et de leurs produits sont cumulées
+ * par colonne sur 8 lignes, puis glissées horizontalement: chaque pixel
+ * n'est lu que deux fois par rangée de fenêtres. Écarts et sommes sont
+ * calculés en un seul passage contigu par ligne pour toutes les
+ * composantes, en entiers 32 bits (valeur_max <= 255), et vectorisés.
+ *
+ * \param image1 pointeur sur la première image (référence)
+ * \param image2 pointeur sur la seconde image
+ * \param comparaison pointeur sur la structure recevant les mesures
+ *
+ * \pre image1!=NULL, image2!=NULL, comparaison!=NULL
+ * \post comparaison complétée
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Images de format, de dimensions ou de valeur maximale différents \n
+ *      -2 Erreur d'allocation de mémoire
+ *
+ */
+int compare_PNM(PNM *image1, PNM *image2, Comparaison_PNM *comparaison);
+
+/**
+ * \fn affiche_comparaison(const Comparaison_PNM *comparaison)
+ * \brief Affiche les mesures d'une comparaison, une ligne par composante puis une ligne globale
+ *
+ * \param comparaison pointeur sur les mesures à afficher
+ *
+ * \pre comparaison!=NULL
+ *
+ */
+void affiche_comparaison(const Comparaison_PNM *comparaison);
+
+#endif
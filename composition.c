@@ -0,0 +1,191 @@
+/**
+ * \file composition.c
+ * \brief Ce fichier contient les opérations entre deux images PNM.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "composition.h"
+#include "ordonnanceur.h"
+#include "pnm.h"
+
+/**
+ * \struct Composition
+ * \brief Opération appliquée tuile par tuile
+ */
+typedef struct {
+    PNM *image, *seconde;
+    Operation_composition operation;
+    unsigned int poids;//poids de seconde pour le mélange, en 65536èmes
+    int nbr_composantes;//composantes de image combinées par pixel
+} Composition;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void compose_tuile(const Tuile *tuile, void *contexte);
+static void compose_segment(const Composition *composition, unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs);
+static void melange(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs, unsigned int poids);
+static void difference(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs);
+static void minimum(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs);
+static void maximum(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs);
+static void masque(unsigned short *restrict a, const unsigned short *restrict m, int nbr_pixels, int nbr_canaux_a, int nbr_canaux_m, int nbr_composantes);
+
+
+int lit_composition(const char *texte, Operation_composition *operation, double *alpha){
+    assert(texte!=NULL && operation!=NULL && alpha!=NULL);
+    char *fin;
+
+    *alpha = ALPHA_MELANGE;
+    if(strncmp(texte, "melange", 7)==0 && (texte[7]=='\0' || texte[7]==',')){
+        *operation = composition_melange;
+        if(texte[7]==','){
+            *alpha = strtod(texte+8, &fin);
+            if(fin==texte+8 || *fin!='\0' || !(*alpha>=0 && *alpha<=1))
+                return -1;
+        }
+    }
+    else if(strcmp(texte, "difference")==0)
+        *operation = composition_difference;
+    else if(strcmp(texte, "minimum")==0)
+        *operation = composition_minimum;
+    else if(strcmp(texte, "maximum")==0)
+        *operation = composition_maximum;
+    else if(strcmp(texte, "masque")==0)
+        *operation = composition_masque;
+    else
+        return -1;
+
+    return 0;
+}
+
+int compose_PNM(PNM *image, PNM *seconde, Operation_composition operation, double alpha){
+    assert(image!=NULL && seconde!=NULL && alpha>=0 && alpha<=1);
+    Composition composition;
+    int format = acces_format_PNM(image);
+
+    if(acces_nbr_ligne_PNM(image)!=acces_nbr_ligne_PNM(seconde) || acces_nbr_colonne_PNM(image)!=acces_nbr_colonne_PNM(seconde)){
+        printf("Les deux images n'ont pas les mêmes dimensions.\n");
+        return -1;
+    }
+    if(operation==composition_masque && acces_format_PNM(seconde)!=1){
+        printf("Le masque doit être une image au format PBM.\n");
+        return -1;
+    }
+    if(operation!=composition_masque &&
+       (format!=acces_format_PNM(seconde) || acces_valeur_max_PNM(image)!=acces_valeur_max_PNM(seconde))){
+        printf("Les deux images doivent avoir le même format et la même valeur max.\n");
+        return -1;
+    }
+
+    composition.image = image;
+    composition.seconde = seconde;
+    composition.operation = operation;
+    composition.poids = (unsigned int)(alpha * 65536 + 0.5);
+    composition.nbr_composantes = (format==3) ? 3 : 1;
+
+    execute_tuiles(acces_nbr_ligne_PNM(image), acces_nbr_colonne_PNM(image), 4 * composition.nbr_composantes,
+                   compose_tuile, &composition);
+
+    return 0;
+}
+
+static void compose_tuile(const Tuile *tuile, void *contexte){
+    Composition *composition = contexte;
+    int nbr_canaux_a = acces_nbr_canaux_PNM(composition->image), nbr_canaux_b = acces_nbr_canaux_PNM(composition->seconde);
+    int nbr_composantes = composition->nbr_composantes;
+    unsigned short *a;
+    const unsigned short *b;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        a = acces_ligne_PNM(composition->image, i) + (size_t)tuile->x * nbr_canaux_a;
+        b = acces_ligne_PNM(composition->seconde, i) + (size_t)tuile->x * nbr_canaux_b;
+
+        if(composition->operation==composition_masque)
+            masque(a, b, tuile->largeur, nbr_canaux_a, nbr_canaux_b, nbr_composantes);
+        //segment contigu, sauf pour une image PPM devenue grise (une seule composante utile sur trois)
+        else if(nbr_canaux_a==nbr_composantes && nbr_canaux_b==nbr_composantes)
+            compose_segment(composition, a, b, tuile->largeur * nbr_composantes);
+        else{
+            for(int j=0; j<tuile->largeur; j++)
+                compose_segment(composition, &a[j*nbr_canaux_a], &b[j*nbr_canaux_b], 1);
+        }
+    }
+}
+
+static void compose_segment(const Composition *composition, unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs){
+    switch(composition->operation){
+    case composition_melange:
+        melange(a, b, nbr_valeurs, composition->poids);
+        break;
+    case composition_difference:
+        difference(a, b, nbr_valeurs);
+        break;
+    case composition_minimum:
+        minimum(a, b, nbr_valeurs);
+        break;
+    case composition_maximum:
+        maximum(a, b, nbr_valeurs);
+        break;
+    default:
+        break;
+    }
+}
+
+//virgule fixe sur 16 bits: a*(65536-poids) + b*poids <= 65535*65536, le calcul tient sur 32 bits
+static void melange(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs, unsigned int poids){
+    unsigned int complement = 65536 - poids;
+
+    for(int k=0; k<nbr_valeurs; k++)
+        a[k] = (unsigned short)((a[k] * complement + b[k] * poids + 32768u) >> 16);
+}
+
+static void difference(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs){
+    for(int k=0; k<nbr_valeurs; k++)
+        a[k] = (a[k] > b[k]) ? a[k] - b[k] : b[k] - a[k];
+}
+
+static void minimum(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs){
+    for(int k=0; k<nbr_valeurs; k++)
+        a[k] = (b[k] < a[k]) ? b[k] : a[k];
+}
+
+static void maximum(unsigned short *restrict a, const unsigned short *restrict b, int nbr_valeurs){
+    for(int k=0; k<nbr_valeurs; k++)
+        a[k] = (b[k] > a[k]) ? b[k] : a[k];
+}
+
+//le masque devient 0xFFFF ou 0: un ET conserve ou annule toutes les composantes du pixel
+NOYAU_VECTORIEL
+static void masque(unsigned short *restrict a, const unsigned short *restrict m, int nbr_pixels, int nbr_canaux_a, int nbr_canaux_m, int nbr_composantes){
+    unsigned short garde;
+
+    if(nbr_canaux_a==1 && nbr_canaux_m==1){
+        for(int j=0; j<nbr_pixels; j++)
+            a[j] &= (unsigned short)-(m[j]!=0);
+        return;
+    }
+    //image PPM et masque PBM ou PGM: pas fixes, les trois composantes d'un pixel en une seule boucle
+    if(nbr_canaux_a==3 && nbr_canaux_m==1 && nbr_composantes==3){
+        for(int j=0; j<nbr_pixels; j++){
+            garde = (unsigned short)-(m[j]!=0);
+            a[3*j] &= garde;
+            a[3*j+1] &= garde;
+            a[3*j+2] &= garde;
+        }
+        return;
+    }
+    for(int j=0; j<nbr_pixels; j++){
+        garde = (unsigned short)-(m[j*nbr_canaux_m]!=0);
+        for(int x=0; x<nbr_composantes; x++)
+            a[j*nbr_canaux_a + x] &= garde;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * \file composition.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes des opérations entre deux images PNM.
+ *
+ * Le résultat est écrit dans la première image. Les opérations sont des
+ * boucles sans branchement sur des segments de ligne contigus, que le
+ * compilateur vectorise (-O3, voir NOYAU_VECTORIEL), appliquées en parallèle
+ * tuile par tuile.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __COMPOSITION__
+#define __COMPOSITION__
+
+#include "pnm.h"
+
+/**
+ * \enum Operation_composition
+ * \brief Opération appliquée à chaque paire de valeurs
+ */
+typedef enum {
+    composition_melange,//(1 - alpha) * image + alpha * seconde
+    composition_difference,//|image - seconde|
+    composition_minimum,
+    composition_maximum,
+    composition_masque//image là où le masque PBM vaut 1, 0 ailleurs
+} Operation_composition;
+
+/**
+ * Poids de la seconde image par défaut pour le mélange
+ */
+#define ALPHA_MELANGE 0.5
+
+/**
+ * \fn lit_composition(const char *texte, Operation_composition *operation, double *alpha)
+ * \brief Lit une opération de la forme melange[,<alpha>]|difference|minimum|maximum|masque
+ *
+ * \param texte l'opération à lire
+ * \param operation pointeur recevant l'opération
+ * \param alpha pointeur recevant le poids de la seconde image (ALPHA_MELANGE par défaut)
+ *
+ * \pre texte!=NULL, operation!=NULL, alpha!=NULL
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Opération inconnue ou alpha hors de [0, 1]
+ *
+ */
+int lit_composition(const char *texte, Operation_composition *operation, double *alpha);
+
+/**
+ * \fn compose_PNM(PNM *image, PNM *seconde, Operation_composition operation, double alpha)
+ * \brief Combine image et seconde pixel par pixel, le résultat remplace image
+ *
+ * Les deux images doivent avoir les mêmes dimensions. Pour le masquage,
+ * seconde est une image PBM (par exemple produite par le filtre NB) et
+ * image a un format quelconque; pour les autres opérations, les deux images
+ * ont le même format et la même valeur max.
+ *
+ * \param image pointeur sur la première image, qui reçoit le résultat
+ * \param seconde pointeur sur la seconde image ou le masque
+ * \param operation l'opération à appliquer
+ * \param alpha le poids de seconde pour composition_melange, ignoré sinon
+ *
+ * \pre image!=NULL, seconde!=NULL, 0<=alpha<=1
+ * \post valeurs du tableau de pixel de image modifiées
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Images incompatibles
+ *
+ */
+int compose_PNM(PNM *image, PNM *seconde, Operation_composition operation, double alpha);
+
+#endif
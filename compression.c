@@ -0,0 +1,214 @@
+/**
+ * \file compression.c
+ * \brief Ce fichier contient l'ouverture transparente de fichiers images compressés (gzip).
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <zlib.h>
+
+#include "compression.h"
+#include "trace.h"
+
+/**
+ * \struct Fichier_compresse
+ * \brief Fichier compressé ouvert et thread qui le (dé)compresse
+ */
+typedef struct {
+    FILE *fichier;//extrémité du programme
+    int descripteur;//extrémité du thread
+    gzFile gz;
+    pthread_t thread;
+    int resultat;
+} Fichier_compresse;
+
+/**
+ * Fichiers compressés ouverts, retrouvés par leur FILE * à la fermeture
+ */
+static Fichier_compresse *ouverts[NBR_MAX_FICHIERS_COMPRESSES];
+static pthread_mutex_t verrou_ouverts = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static FILE *ouvre_compresse(const char *filename, int ecriture);
+static void *decompresse_blocs(void *arg);
+static void *compresse_blocs(void *arg);
+static int enregistre(Fichier_compresse *compresse);
+static Fichier_compresse *retire(FILE *fichier);
+
+
+int est_compresse(const char *filename){
+    assert(filename!=NULL);
+    size_t taille = strlen(filename);
+
+    return (taille>3 && strcmp(filename + taille - 3, ".gz")==0);
+}
+
+FILE *ouvre_fichier_image(const char *filename, const char *mode){
+    assert(filename!=NULL && mode!=NULL && (mode[0]=='r' || mode[0]=='w'));
+
+    if(est_compresse(filename))
+        return ouvre_compresse(filename, mode[0]=='w');
+    return fopen(filename, mode);
+}
+
+int ferme_fichier_image(FILE *fichier){
+    assert(fichier!=NULL);
+    Fichier_compresse *compresse = retire(fichier);
+    int resultat = (fclose(fichier)==0) ? 0 : -1;
+
+    //la fermeture de l'extrémité du programme termine le thread (fin des données ou lecture abandonnée)
+    if(compresse!=NULL){
+        pthread_join(compresse->thread, NULL);
+        if(compresse->resultat!=0)
+            resultat = -1;
+        free(compresse);
+    }
+
+    return resultat;
+}
+
+static FILE *ouvre_compresse(const char *filename, int ecriture){
+    Fichier_compresse *compresse;
+    int descripteurs[2];
+
+    compresse = malloc(sizeof(Fichier_compresse));
+    if(compresse==NULL)
+        return NULL;
+    compresse->resultat = 0;
+
+    compresse->gz = gzopen(filename, ecriture ? "wb6" : "rb");
+    if(compresse->gz==NULL){
+        free(compresse);
+        return NULL;
+    }
+    gzbuffer(compresse->gz, TAILLE_BLOC_COMPRESSION);
+
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, descripteurs)!=0){
+        gzclose(compresse->gz);
+        free(compresse);
+        return NULL;
+    }
+    compresse->descripteur = descripteurs[1];
+    compresse->fichier = fdopen(descripteurs[0], ecriture ? "w" : "r");
+    if(compresse->fichier==NULL){
+        close(descripteurs[0]);
+        close(descripteurs[1]);
+        gzclose(compresse->gz);
+        free(compresse);
+        return NULL;
+    }
+
+    if(enregistre(compresse)!=0 ||
+       pthread_create(&compresse->thread, NULL, ecriture ? compresse_blocs : decompresse_blocs, compresse)!=0){
+        retire(compresse->fichier);
+        fclose(compresse->fichier);
+        close(compresse->descripteur);
+        gzclose(compresse->gz);
+        free(compresse);
+        return NULL;
+    }
+
+    return compresse->fichier;
+}
+
+static void *decompresse_blocs(void *arg){
+    Fichier_compresse *compresse = arg;
+    char tampon[TAILLE_BLOC_COMPRESSION];
+    int lus, envoye;
+    unsigned long long trace = debut_trace();
+
+    //chaque bloc décompressé est transmis pendant que le programme analyse le précédent
+    while((lus = gzread(compresse->gz, tampon, TAILLE_BLOC_COMPRESSION))>0){
+        for(int ecrits=0; ecrits<lus; ecrits+=envoye){
+            envoye = send(compresse->descripteur, tampon + ecrits, lus - ecrits, MSG_NOSIGNAL);
+            if(envoye<0 && errno==EINTR)
+                envoye = 0;
+            else if(envoye<0){
+                //le programme a fermé le fichier avant la fin (lecture de l'en tête seulement)
+                lus = 0;
+                break;
+            }
+        }
+        if(lus==0)
+            break;
+    }
+    if(lus<0)
+        compresse->resultat = -1;
+
+    gzclose(compresse->gz);
+    close(compresse->descripteur);
+    fin_trace("decompression", trace);
+    return NULL;
+}
+
+static void *compresse_blocs(void *arg){
+    Fichier_compresse *compresse = arg;
+    char tampon[TAILLE_BLOC_COMPRESSION];
+    ssize_t lus;
+    unsigned long long trace = debut_trace();
+
+    //les données sont reçues jusqu'à la fermeture, même après une erreur, pour ne jamais bloquer le programme
+    while((lus = recv(compresse->descripteur, tampon, TAILLE_BLOC_COMPRESSION, 0))!=0){
+        if(lus<0){
+            if(errno==EINTR)
+                continue;
+            compresse->resultat = -1;
+            break;
+        }
+        if(compresse->resultat==0 && gzwrite(compresse->gz, tampon, lus)!=lus)
+            compresse->resultat = -1;
+    }
+
+    if(gzclose(compresse->gz)!=Z_OK)
+        compresse->resultat = -1;
+    close(compresse->descripteur);
+    fin_trace("compression", trace);
+    return NULL;
+}
+
+static int enregistre(Fichier_compresse *compresse){
+    int resultat = -1;
+
+    pthread_mutex_lock(&verrou_ouverts);
+    for(int k=0; k<NBR_MAX_FICHIERS_COMPRESSES; k++){
+        if(ouverts[k]==NULL){
+            ouverts[k] = compresse;
+            resultat = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&verrou_ouverts);
+
+    return resultat;
+}
+
+static Fichier_compresse *retire(FILE *fichier){
+    Fichier_compresse *compresse = NULL;
+
+    pthread_mutex_lock(&verrou_ouverts);
+    for(int k=0; k<NBR_MAX_FICHIERS_COMPRESSES; k++){
+        if(ouverts[k]!=NULL && ouverts[k]->fichier==fichier){
+            compresse = ouverts[k];
+            ouverts[k] = NULL;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&verrou_ouverts);
+
+    return compresse;
+}
@@ -0,0 +1,80 @@
+/**
+ * \file compression.h
+ * \brief Ce fichier contient les prototypes de l'ouverture transparente de fichiers images compressés (gzip).
+ *
+ * Un fichier dont le nom se termine par ".gz" est lu ou écrit à travers zlib
+ * par un thread dédié, relié au programme par une paire de sockets locales:
+ * le programme manipule un FILE * ordinaire (non positionnable) pendant que
+ * le thread décompresse les données suivantes, ou compresse les données déjà
+ * écrites. Les autres fichiers sont ouverts directement.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __COMPRESSION__
+#define __COMPRESSION__
+
+#include <stdio.h>
+
+/**
+ * Taille (en octets) des blocs échangés entre zlib et le programme
+ */
+#define TAILLE_BLOC_COMPRESSION (128 << 10)
+
+/**
+ * Nombre maximal de fichiers compressés ouverts simultanément
+ */
+#define NBR_MAX_FICHIERS_COMPRESSES 64
+
+/**
+ * \fn est_compresse(const char *filename)
+ * \brief Indique si filename désigne un fichier compressé
+ *
+ * \param filename le nom de fichier
+ *
+ * \pre filename!=NULL
+ *
+ * \return
+ *       1 filename se termine par ".gz" \n
+ *       0 sinon
+ *
+ */
+int est_compresse(const char *filename);
+
+/**
+ * \fn *ouvre_fichier_image(const char *filename, const char *mode)
+ * \brief Ouvre filename en lecture ou en écriture, à travers zlib s'il est compressé
+ *
+ * \param filename le fichier à ouvrir
+ * \param mode "r" ou "w"
+ *
+ * \pre filename!=NULL, mode vaut "r" ou "w"
+ * \post /
+ *
+ * \return
+ *      NULL si le fichier ne peut être ouvert \n
+ *      un pointeur sur FILE sinon, à fermer avec ferme_fichier_image
+ *
+ */
+FILE *ouvre_fichier_image(const char *filename, const char *mode);
+
+/**
+ * \fn ferme_fichier_image(FILE *fichier)
+ * \brief Ferme un fichier ouvert par ouvre_fichier_image et attend la fin de sa (dé)compression
+ *
+ * \param fichier le fichier à fermer
+ *
+ * \pre fichier!=NULL
+ * \post un fichier compressé écrit est complet sur le disque
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Erreur lors de la fermeture ou de la (dé)compression
+ *
+ */
+int ferme_fichier_image(FILE *fichier);
+
+#endif
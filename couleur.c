@@ -0,0 +1,226 @@
+/**
+ * \file couleur.c
+ * \brief Ce fichier contient les fonctions de transformation de couleur d'images PNM.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "couleur.h"
+#include "pnm.h"
+
+/**
+ * Nombre de bits de la partie décimale des coefficients en virgule fixe
+ */
+#define BITS_VIRGULE 14
+
+/**
+ * \struct Transformation_predefinie
+ * \brief Nom et coefficients d'une transformation prédéfinie
+ */
+typedef struct {
+    const char *nom;
+    double coefficients[3][4];
+} Transformation_predefinie;
+
+/**
+ * Transformations prédéfinies, terminées par un nom NULL
+ * 
+ */
+static const Transformation_predefinie predefinies[] = {
+    {"sepia", {{0.393, 0.769, 0.189, 0}, {0.349, 0.686, 0.168, 0}, {0.272, 0.534, 0.131, 0}}},
+    {"ycbcr", {{0.299, 0.587, 0.114, 0}, {-0.168736, -0.331264, 0.5, 0.5}, {0.5, -0.418688, -0.081312, 0.5}}},
+    {"ycbcr_inverse", {{1, 0, 1.402, -0.701}, {1, -0.344136, -0.714136, 0.529136}, {1, 1.772, 0, -0.886}}},
+    {"r", {{1, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}}},
+    {"v", {{0, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 0, 0}}},
+    {"b", {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 1, 0}}},
+    {"rbv", {{1, 0, 0, 0}, {0, 0, 1, 0}, {0, 1, 0, 0}}},
+    {"vrb", {{0, 1, 0, 0}, {1, 0, 0, 0}, {0, 0, 1, 0}}},
+    {"vbr", {{0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 0}}},
+    {"brv", {{0, 0, 1, 0}, {1, 0, 0, 0}, {0, 1, 0, 0}}},
+    {"bvr", {{0, 0, 1, 0}, {0, 1, 0, 0}, {1, 0, 0, 0}}},
+    {NULL, {{0}}}
+};
+
+/**
+ * Déclaration des fonctions statiques
+ * 
+ */
+static void transforme_ligne(unsigned short *ligne, int nbr_colonne, const int coefficients[3][4], int valeur_max);
+static void ajuste_ligne_tsv(unsigned short *ligne, int nbr_colonne, double teinte, double saturation, double valeur_max);
+static inline unsigned short composante_tsv(int maximum, double s, double k, double valeur_max);
+static inline double profil_secteur(double k);
+
+
+int matrice_couleur_predefinie(Matrice_couleur *matrice, const char *nom){
+    assert(matrice!=NULL && nom!=NULL);
+
+    for(int i=0; predefinies[i].nom!=NULL; i++){
+        if(strcmp(predefinies[i].nom, nom)==0){
+            memcpy(matrice->coefficients, predefinies[i].coefficients, sizeof(matrice->coefficients));
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int verifie_matrice_couleur(const Matrice_couleur *matrice){
+    assert(matrice!=NULL);
+
+    for(int i=0; i<3; i++){
+        for(int x=0; x<4; x++){
+            if(!isfinite(matrice->coefficients[i][x]) || fabs(matrice->coefficients[i][x]) > COEFFICIENT_MAX_MATRICE)
+                return -1;
+        }
+    }
+
+    return 0;
+}
+
+int verifie_teinte_saturation(double teinte, double saturation){
+    if(!isfinite(teinte) || !isfinite(saturation) || saturation<0 || saturation>SATURATION_MAX_TEINTE)
+        return -1;
+
+    return 0;
+}
+
+int applique_matrice_couleur(PNM *image, const Matrice_couleur *matrice){
+    assert(image!=NULL && matrice!=NULL);
+    int coefficients[3][4];
+    int valeur_max = acces_valeur_max_PNM(image);
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
+
+    if(acces_format_PNM(image)!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour y appliquer une matrice de couleur.\n");
+        return -1;
+    }
+    if(verifie_matrice_couleur(matrice)!=0){
+        printf("Les coefficients de la matrice de couleur doivent être finis et compris entre -%d et %d.\n", COEFFICIENT_MAX_MATRICE, COEFFICIENT_MAX_MATRICE);
+        return -2;
+    }
+    assert(valeur_max <= 255);
+
+    //conversion unique en virgule fixe; le décalage intègre l'arrondi au plus proche
+    for(int i=0; i<3; i++){
+        for(int x=0; x<3; x++)
+            coefficients[i][x] = (int)lround(matrice->coefficients[i][x] * (1 << BITS_VIRGULE));
+        coefficients[i][3] = (int)lround(matrice->coefficients[i][3] * valeur_max * (1 << BITS_VIRGULE)) + (1 << (BITS_VIRGULE-1));
+    }
+
+    for(int i=0; i<nbr_ligne; i++)
+        transforme_ligne(acces_ligne_PNM(image, i), nbr_colonne, (const int (*)[4])coefficients, valeur_max);
+
+    return 0;
+}
+
+int ajuste_teinte_saturation(PNM *image, double teinte, double saturation){
+    assert(image!=NULL);
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
+    double valeur_max = acces_valeur_max_PNM(image);
+    unsigned short *ligne;
+
+    if(acces_format_PNM(image)!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour y ajuster la teinte.\n");
+        return -1;
+    }
+    if(verifie_teinte_saturation(teinte, saturation)!=0){
+        printf("La teinte doit être finie et la saturation comprise entre 0 et %d.\n", SATURATION_MAX_TEINTE);
+        return -2;
+    }
+
+    //teinte ramenée dans [0, 6[ (un secteur de 60 degrés par unité)
+    teinte = fmod(teinte / 60.0, 6.0);
+    if(teinte<0)
+        teinte += 6.0;
+    if(teinte>=6.0)//arrondi d'un très petit décalage négatif
+        teinte -= 6.0;
+
+    for(int i=0; i<nbr_ligne; i++){
+        ligne = acces_ligne_PNM(image, i);
+        ajuste_ligne_tsv(ligne, nbr_colonne, teinte, saturation, valeur_max);
+    }
+
+    return 0;
+}
+
+NOYAU_VECTORIEL
+static void transforme_ligne(unsigned short *ligne, int nbr_colonne, const int coefficients[3][4], int valeur_max){
+    int r, v, b, resultat[3];
+
+    //accumulateurs 32 bits: au plus 4 * COEFFICIENT_MAX_MATRICE * 2^14 * 255 < 2^31, aucun débordement
+    for(int j=0; j<nbr_colonne; j++){
+        r = ligne[3*j];
+        v = ligne[3*j+1];
+        b = ligne[3*j+2];
+        for(int x=0; x<3; x++){
+            resultat[x] = (coefficients[x][0]*r + coefficients[x][1]*v + coefficients[x][2]*b + coefficients[x][3]) >> BITS_VIRGULE;
+            resultat[x] = resultat[x] < 0 ? 0 : resultat[x];
+            resultat[x] = resultat[x] > valeur_max ? valeur_max : resultat[x];
+        }
+        ligne[3*j] = resultat[0];
+        ligne[3*j+1] = resultat[1];
+        ligne[3*j+2] = resultat[2];
+    }
+}
+
+NOYAU_VECTORIEL
+static void ajuste_ligne_tsv(unsigned short *ligne, int nbr_colonne, double teinte, double saturation, double valeur_max){
+    int r, v, b, maximum, minimum, etendue, est_r, est_v, est_b, difference, secteur;
+    double t, s;
+
+    /*ni fmod ni switch: le secteur de teinte est choisi par des produits entiers et des bornes, que le
+    compilateur vectorise (une soustraction flottante conditionnelle ne le serait pas: elle pourrait lever
+    une exception)*/
+    for(int j=0; j<nbr_colonne; j++){
+        r = ligne[3*j];
+        v = ligne[3*j+1];
+        b = ligne[3*j+2];
+        maximum = r > v ? r : v;
+        maximum = maximum > b ? maximum : b;
+        minimum = r < v ? r : v;
+        minimum = minimum < b ? minimum : b;
+        etendue = maximum - minimum;
+
+        //RVB -> TSV: t dans [0, 6[ décalé de teinte, donc dans [0, 12[ (un pixel gris a une saturation nulle et reste inchangé)
+        est_r = (maximum==r);
+        est_v = !est_r & (maximum==v);
+        est_b = !est_r & !est_v;
+        difference = est_r*(v - b) + est_v*(b - r) + est_b*(r - v);
+        secteur = est_r*6*(difference < 0) + est_v*2 + est_b*4;
+        t = (double)difference / (etendue + (etendue==0)) + secteur + teinte;
+        s = (double)etendue / (maximum + (maximum==0)) * saturation;
+        s = s < 1.0 ? s : 1.0;
+
+        /*TSV -> RVB: la composante de décalage n (5 pour r, 3 pour v, 1 pour b) vaut maximum * (1 - s * p(k))
+        avec k = n + t modulo 6 et p(k) = min(max(min(k, 4-k), 0), 1). p étant nulle hors de [0, 4],
+        p(k modulo 6) = max(p(k), p(k-6), p(k-12)) pour k dans [0, 18[*/
+        ligne[3*j] = composante_tsv(maximum, s, 5.0 + t, valeur_max);
+        ligne[3*j+1] = composante_tsv(maximum, s, 3.0 + t, valeur_max);
+        ligne[3*j+2] = composante_tsv(maximum, s, 1.0 + t, valeur_max);
+    }
+}
+
+static inline unsigned short composante_tsv(int maximum, double s, double k, double valeur_max){
+    double p = profil_secteur(k), p_6 = profil_secteur(k - 6.0), p_12 = profil_secteur(k - 12.0), resultat;
+
+    p = p > p_6 ? p : p_6;
+    p = p > p_12 ? p : p_12;
+    resultat = maximum * (1 - s*p) + 0.5;
+    resultat = resultat < valeur_max ? resultat : valeur_max;
+    return (unsigned short)resultat;
+}
+
+static inline double profil_secteur(double k){
+    k = k < 4.0 - k ? k : 4.0 - k;
+    k = k > 0.0 ? k : 0.0;
+    k = k < 1.0 ? k : 1.0;
+    return k;
+}
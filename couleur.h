@@ -0,0 +1,179 @@
+/**
+ * \file couleur.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes des fonctions de transformation de couleur d'images PNM.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+//Include guard
+#ifndef __COULEUR__
+#define __COULEUR__
+
+#include "pnm.h"
+
+/**
+ * Valeur absolue maximale d'un coefficient de matrice: en virgule fixe
+ * (14 bits de partie décimale), les sommes restent dans un entier 32 bits
+ * pour toute valeur_max <= 255
+ */
+#define COEFFICIENT_MAX_MATRICE 64
+
+/**
+ * Facteur de saturation maximal: à partir de valeur_max (au plus 255), toute
+ * couleur qui n'est pas grise est déjà entièrement saturée
+ */
+#define SATURATION_MAX_TEINTE 255
+
+/**
+ * \struct Matrice_couleur
+ * \brief Transformation affine 3x4 des composantes (r, v, b) d'un pixel
+ * 
+ * La composante i du résultat vaut coefficients[i][0]*r + coefficients[i][1]*v
+ * + coefficients[i][2]*b + coefficients[i][3]*valeur_max.
+ * 
+ */
+typedef struct {
+    double coefficients[3][4];
+} Matrice_couleur;
+
+/**
+ * \fn matrice_couleur_predefinie(Matrice_couleur *matrice, const char *nom)
+ * \brief Remplit matrice avec une transformation prédéfinie
+ * 
+ * Transformations disponibles: "sepia", "ycbcr" (BT.601, Cb et Cr centrés
+ * sur valeur_max/2), "ycbcr_inverse", "r", "v", "b" (isolation d'une
+ * composante, comme le filtre monochrome) et les permutations "rbv", "vrb",
+ * "vbr", "brv", "bvr" (la composante i du résultat est la composante nommée
+ * par la lettre i).
+ * 
+ * \param matrice pointeur sur Matrice_couleur à remplir
+ * \param nom chaine de caractère contenant le nom de la transformation
+ * 
+ * \pre matrice!=NULL, nom!=NULL
+ * \post /
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Aucune transformation ne porte ce nom
+ * 
+ */
+int matrice_couleur_predefinie(Matrice_couleur *matrice, const char *nom);
+
+/**
+ * \fn verifie_matrice_couleur(const Matrice_couleur *matrice)
+ * \brief Vérifie que chaque coefficient de matrice est fini et borné par COEFFICIENT_MAX_MATRICE
+ * 
+ * \param matrice pointeur sur la transformation à vérifier
+ * 
+ * \pre matrice!=NULL
+ * \post /
+ * 
+ * \return
+ *       0 Coefficients corrects \n
+ *      -1 Coefficient infini, NaN ou trop grand
+ * 
+ */
+int verifie_matrice_couleur(const Matrice_couleur *matrice);
+
+/**
+ * \fn applique_matrice_couleur(PNM *image, const Matrice_couleur *matrice)
+ * \brief Applique une transformation affine à chaque pixel d'une image PPM
+ * 
+ * Les coefficients sont convertis une seule fois en virgule fixe, la boucle
+ * interne ne fait que des multiplications et additions entières sur 32 bits
+ * et est vectorisée. Les résultats sont bornés entre 0 et valeur_max.
+ * Le filtre monochrome utilise les transformations "r", "v" et "b".
+ * 
+ * \param image pointeur sur PNM auquel appliquer la transformation
+ * \param matrice pointeur sur la transformation à appliquer
+ * 
+ * \pre image!=NULL, matrice!=NULL
+ * \post valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de ppm \n
+ *      -2 Coefficient incorrect (voir verifie_matrice_couleur)
+ * 
+ */
+int applique_matrice_couleur(PNM *image, const Matrice_couleur *matrice);
+
+/**
+ * \fn ajuste_teinte_saturation(PNM *image, double teinte, double saturation)
+ * \brief Décale la teinte et multiplie la saturation de chaque pixel d'une image PPM
+ * 
+ * Chaque pixel est converti en TSV (teinte, saturation, valeur), modifié puis
+ * reconverti en RVB. Les deux conversions sont écrites sans branchement
+ * (sélections et bornes): la boucle sur les pixels d'une ligne est vectorisée.
+ * 
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param teinte décalage de la teinte, en degrés
+ * \param saturation facteur multiplicatif de la saturation
+ * 
+ * \pre image!=NULL
+ * \post valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de ppm \n
+ *      -2 Teinte ou saturation incorrecte (voir verifie_teinte_saturation)
+ * 
+ */
+int ajuste_teinte_saturation(PNM *image, double teinte, double saturation);
+
+/**
+ * \fn verifie_teinte_saturation(double teinte, double saturation)
+ * \brief Vérifie que teinte est finie et que saturation est finie et comprise entre 0 et SATURATION_MAX_TEINTE
+ * 
+ * \param teinte décalage de la teinte, en degrés
+ * \param saturation facteur multiplicatif de la saturation
+ * 
+ * \pre /
+ * \post /
+ * 
+ * \return
+ *       0 Paramètres corrects \n
+ *      -1 Paramètre infini, nan ou hors des bornes
+ * 
+ */
+int verifie_teinte_saturation(double teinte, double saturation);
+
+/**
+ * \fn luminance_couleur(unsigned int r, unsigned int v, unsigned int b)
+ * \brief Luminance 0.299 r + 0.587 v + 0.114 b en virgule fixe (millièmes), arrondie au-dessus si > 0.5
+ * 
+ * Formule commune au filtre gris, à l'égalisation et au filtre bilatéral.
+ * Entièrement entière, elle est vectorisée dans les boucles qui l'appellent.
+ * 
+ * \param r, v, b les composantes d'un pixel
+ * 
+ * \pre r, v, b <= 65535
+ * \post /
+ * 
+ * \return la luminance, entre 0 et la plus grande composante
+ * 
+ */
+static inline unsigned int luminance_couleur(unsigned int r, unsigned int v, unsigned int b){
+    return (299u*r + 587u*v + 114u*b + 499u) / 1000u;
+}
+
+/**
+ * \fn luminance_pixel(const unsigned short *pixel, int couleur)
+ * \brief Luminance d'un pixel PPM (couleur!=0) ou valeur d'un pixel PGM
+ * 
+ * \param pixel les valeurs du pixel
+ * \param couleur 1 si pixel a trois composantes, 0 s'il n'en a qu'une
+ * 
+ * \pre pixel!=NULL
+ * \post /
+ * 
+ * \return luminance_couleur des trois composantes, ou pixel[0]
+ * 
+ */
+static inline unsigned int luminance_pixel(const unsigned short *pixel, int couleur){
+    return couleur ? luminance_couleur(pixel[0], pixel[1], pixel[2]) : pixel[0];
+}
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * \file derivation.c
+ * \brief Ce fichier contient les dérivations multiples d'une image chargée une seule fois.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "derivation.h"
+#include "registre.h"
+#include "pnm.h"
+
+/**
+ * \struct Thread_derivation
+ * \brief Une dérivation et la source partagée, traitées par un thread
+ */
+typedef struct {
+    PNM *source;
+    Derivation *derivation;
+} Thread_derivation;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void *derive(void *arg);
+
+
+int lit_derivation(char *texte, Derivation *derivation){
+    assert(texte!=NULL && derivation!=NULL);
+    char *egal = strchr(texte, '='), *deux_points;
+
+    //le nom de fichier suit le premier '=', le paramètre éventuel suit le premier ':' du filtre
+    if(egal==NULL || egal[1]=='\0')
+        return -4;
+    *egal = '\0';
+    derivation->filename_output = egal + 1;
+    derivation->resultat = -1;
+
+    deux_points = strchr(texte, ':');
+    if(deux_points!=NULL)
+        *deux_points = '\0';
+
+    return prepare_filtre(&derivation->filtre, texte, (deux_points!=NULL) ? deux_points + 1 : NULL);
+}
+
+int execute_derivations(PNM *source, Derivation *derivations, int nbr_derivations){
+    assert(source!=NULL && derivations!=NULL && nbr_derivations>=0 && nbr_derivations<=NBR_MAX_DERIVATIONS);
+    Thread_derivation arguments[NBR_MAX_DERIVATIONS];
+    pthread_t threads[NBR_MAX_DERIVATIONS];
+    int lance[NBR_MAX_DERIVATIONS], nbr_echecs = 0;
+
+    //un thread par dérivation; les filtres répartissent eux-mêmes leur travail sur les coeurs
+    for(int d=0; d<nbr_derivations; d++){
+        arguments[d].source = source;
+        arguments[d].derivation = &derivations[d];
+        lance[d] = (d<nbr_derivations-1 && pthread_create(&threads[d], NULL, derive, &arguments[d])==0);
+        if(!lance[d])
+            derive(&arguments[d]);
+    }
+    for(int d=0; d<nbr_derivations; d++){
+        if(lance[d])
+            pthread_join(threads[d], NULL);
+        if(derivations[d].resultat!=0)
+            nbr_echecs++;
+    }
+
+    return nbr_echecs;
+}
+
+static void *derive(void *arg){
+    Thread_derivation *thread = arg;
+    Derivation *derivation = thread->derivation;
+    PNM *image;
+
+    derivation->resultat = -1;
+    image = copie_PNM(thread->source);
+    if(image==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        return NULL;
+    }
+
+    if(applique_filtre(&derivation->filtre, image)==0 && verifie_extension_fichier(derivation->filename_output, image)==0
+       && write_pnm(image, derivation->filename_output)==0){
+        printf("Le filtre %s a correctement été appliqué et enregistré dans %s.\n", derivation->filtre.descripteur->nom,
+               derivation->filename_output);
+        derivation->resultat = 0;
+    }
+    libere_PNM(&image);
+
+    return NULL;
+}
@@ -0,0 +1,74 @@
+/**
+ * \file derivation.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes des dérivations multiples d'une image.
+ *
+ * Une image chargée une seule fois sert de source à plusieurs filtres, chacun
+ * écrit dans son propre fichier. La source n'est que lue: chaque dérivation
+ * travaille sur sa propre copie, ce qui permet de les exécuter en parallèle
+ * même pour les filtres qui changent le format de l'image (gris, NB).
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __DERIVATION__
+#define __DERIVATION__
+
+#include "pnm.h"
+#include "registre.h"
+
+/**
+ * Nombre maximal de dérivations d'une même image
+ */
+#define NBR_MAX_DERIVATIONS 16
+
+/**
+ * \struct Derivation
+ * \brief Un filtre préparé et le fichier recevant son résultat
+ */
+typedef struct {
+    Filtre_prepare filtre;
+    char *filename_output;
+    int resultat;//0 si le résultat a été écrit, -1 sinon (complété par execute_derivations)
+} Derivation;
+
+/**
+ * \fn lit_derivation(char *texte, Derivation *derivation)
+ * \brief Lit et prépare une dérivation de la forme <filtre>[:<paramètre>]=<image_output>
+ *
+ * \param texte la dérivation à lire, découpée sur place (':' et '=' remplacés par '\\0')
+ * \param derivation pointeur sur la dérivation à remplir
+ *
+ * \pre texte!=NULL, derivation!=NULL
+ * \post derivation->filename_output pointe dans texte
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Aucun filtre ne porte ce nom \n
+ *      -2 Paramètre nécessaire manquant \n
+ *      -3 Paramètre incorrect \n
+ *      -4 Forme incorrecte (image output absente)
+ *
+ */
+int lit_derivation(char *texte, Derivation *derivation);
+
+/**
+ * \fn execute_derivations(PNM *source, Derivation *derivations, int nbr_derivations)
+ * \brief Applique chaque dérivation à une copie de source et écrit son résultat, en parallèle
+ *
+ * \param source l'image chargée, qui n'est pas modifiée
+ * \param derivations tableau des dérivations préparées par lit_derivation
+ * \param nbr_derivations le nombre de dérivations
+ *
+ * \pre source!=NULL, derivations!=NULL, 0<=nbr_derivations<=NBR_MAX_DERIVATIONS
+ * \post le champ resultat de chaque dérivation est complété
+ *
+ * \return
+ *      le nombre de dérivations qui ont échoué
+ *
+ */
+int execute_derivations(PNM *source, Derivation *derivations, int nbr_derivations);
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * \file egalisation.c
+ * \brief Ce fichier contient l'égalisation d'histogramme et CLAHE pour images PNM.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "egalisation.h"
+#include "ordonnanceur.h"
+#include "pnm.h"
+#include "couleur.h"
+
+/**
+ * \struct Egalisation
+ * \brief Histogrammes, tables de correspondance et interpolation partagés par les tâches
+ */
+typedef struct {
+    PNM *image;
+    int nbr_canaux, couleur;//couleur: 1 si la luminance d'une image PPM est égalisée
+    unsigned int valeur_max;
+    int nbr_classes;
+    int nbr_bandes;//égalisation globale: bandes de lignes dont l'histogramme est calculé par une tâche
+    int nbr_tuiles_x, nbr_tuiles_y;//CLAHE
+    double limite;
+    unsigned int *histogrammes;//un histogramme par bande ou par tuile
+    unsigned short *tables;//une table de correspondance par tuile (une seule pour l'égalisation globale)
+    int *gauche;//CLAHE: par colonne, tuile dont le centre est à gauche ou sur la colonne
+    double *poids;//CLAHE: par colonne, poids de la tuile de droite
+} Egalisation;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static int prepare_egalisation(Egalisation *egalisation, PNM *image);
+static void histogramme_bande(int indice, void *contexte);
+static void table_tuile(int indice, void *contexte);
+static void egalise_tuile(const Tuile *tuile, void *contexte);
+static void interpole_tuile(const Tuile *tuile, void *contexte);
+static void histogramme_rectangle(const Egalisation *egalisation, unsigned int *histogramme, int x0, int y0, int x1, int y1);
+static inline void remplace_luminance(unsigned short *pixel, const Egalisation *egalisation, unsigned int ancienne, unsigned int nouvelle);
+
+
+int egalisation_histogramme(PNM *image){
+    assert(image!=NULL);
+    Egalisation egalisation;
+    unsigned long long nbr_pixels, cumul = 0, minimum = 0;
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_classes;
+
+    if(prepare_egalisation(&egalisation, image)!=0)
+        return -1;
+    nbr_classes = egalisation.nbr_classes;
+
+    egalisation.nbr_bandes = nombre_threads_disponibles();
+    if(egalisation.nbr_bandes > nbr_ligne)
+        egalisation.nbr_bandes = nbr_ligne;
+    if(egalisation.nbr_bandes < 1)
+        egalisation.nbr_bandes = 1;
+    egalisation.histogrammes = malloc((size_t)egalisation.nbr_bandes * nbr_classes * sizeof(unsigned int));
+    egalisation.tables = malloc((size_t)nbr_classes * sizeof(unsigned short));
+    if(egalisation.histogrammes==NULL || egalisation.tables==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        free(egalisation.histogrammes);
+        free(egalisation.tables);
+        return -2;
+    }
+
+    //un histogramme par bande, additionnés ensuite dans le premier
+    execute_taches(egalisation.nbr_bandes, histogramme_bande, &egalisation);
+    for(int b=1; b<egalisation.nbr_bandes; b++){
+        for(int k=0; k<nbr_classes; k++)
+            egalisation.histogrammes[k] += egalisation.histogrammes[(size_t)b*nbr_classes + k];
+    }
+
+    nbr_pixels = (unsigned long long)nbr_ligne * acces_nbr_colonne_PNM(image);
+    for(int k=0; k<nbr_classes; k++){
+        cumul += egalisation.histogrammes[k];
+        if(minimum==0)
+            minimum = cumul;
+        //image constante: la table est l'identité
+        if(nbr_pixels==minimum)
+            egalisation.tables[k] = (unsigned short)k;
+        else
+            egalisation.tables[k] = (unsigned short)(((cumul - minimum) * egalisation.valeur_max + (nbr_pixels - minimum) / 2)
+                                                     / (nbr_pixels - minimum));
+    }
+
+    execute_tuiles(nbr_ligne, acces_nbr_colonne_PNM(image), egalisation.nbr_canaux * sizeof(unsigned short),
+                   egalise_tuile, &egalisation);
+
+    free(egalisation.histogrammes);
+    free(egalisation.tables);
+
+    return 0;
+}
+
+int clahe(PNM *image, int nbr_tuiles, double limite){
+    assert(image!=NULL && nbr_tuiles>=1 && limite>=1 && limite<=LIMITE_MAX_CLAHE);
+    Egalisation egalisation;
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image), nbr_tables;
+    double position;
+
+    if(prepare_egalisation(&egalisation, image)!=0)
+        return -1;
+    if(nbr_ligne==0 || nbr_colonne==0)
+        return 0;
+
+    egalisation.nbr_tuiles_x = (nbr_tuiles < nbr_colonne) ? nbr_tuiles : nbr_colonne;
+    egalisation.nbr_tuiles_y = (nbr_tuiles < nbr_ligne) ? nbr_tuiles : nbr_ligne;
+    egalisation.limite = limite;
+    nbr_tables = egalisation.nbr_tuiles_x * egalisation.nbr_tuiles_y;
+    egalisation.histogrammes = malloc((size_t)nbr_tables * egalisation.nbr_classes * sizeof(unsigned int));
+    egalisation.tables = malloc((size_t)nbr_tables * egalisation.nbr_classes * sizeof(unsigned short));
+    egalisation.gauche = malloc(nbr_colonne * sizeof(int));
+    egalisation.poids = malloc(nbr_colonne * sizeof(double));
+    if(egalisation.histogrammes==NULL || egalisation.tables==NULL || egalisation.gauche==NULL || egalisation.poids==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        free(egalisation.histogrammes);
+        free(egalisation.tables);
+        free(egalisation.gauche);
+        free(egalisation.poids);
+        return -2;
+    }
+
+    //une tâche par tuile: histogramme, écrêtage et table de correspondance
+    execute_taches(nbr_tables, table_tuile, &egalisation);
+
+    //position de chaque colonne par rapport aux centres des tuiles, commune à toutes les lignes
+    for(int j=0; j<nbr_colonne; j++){
+        position = (j + 0.5) * egalisation.nbr_tuiles_x / nbr_colonne - 0.5;
+        egalisation.gauche[j] = (int)floor(position);
+        egalisation.poids[j] = position - egalisation.gauche[j];
+        if(egalisation.gauche[j] < 0){
+            egalisation.gauche[j] = 0;
+            egalisation.poids[j] = 0;
+        }
+        if(egalisation.gauche[j] >= egalisation.nbr_tuiles_x-1){
+            egalisation.gauche[j] = egalisation.nbr_tuiles_x-1;
+            egalisation.poids[j] = 0;
+        }
+    }
+
+    execute_tuiles(nbr_ligne, nbr_colonne, egalisation.nbr_canaux * sizeof(unsigned short), interpole_tuile, &egalisation);
+
+    free(egalisation.histogrammes);
+    free(egalisation.tables);
+    free(egalisation.gauche);
+    free(egalisation.poids);
+
+    return 0;
+}
+
+static int prepare_egalisation(Egalisation *egalisation, PNM *image){
+    int format = acces_format_PNM(image);
+
+    if(format!=2 && format!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PGM ou PPM pour y égaliser l'histogramme.\n");
+        return -1;
+    }
+
+    memset(egalisation, 0, sizeof(Egalisation));
+    egalisation->image = image;
+    egalisation->nbr_canaux = acces_nbr_canaux_PNM(image);
+    egalisation->couleur = (format==3);
+    egalisation->valeur_max = acces_valeur_max_PNM(image);
+    egalisation->nbr_classes = (int)egalisation->valeur_max + 1;
+
+    return 0;
+}
+
+static void histogramme_bande(int indice, void *contexte){
+    Egalisation *egalisation = contexte;
+    int nbr_ligne = acces_nbr_ligne_PNM(egalisation->image);
+
+    histogramme_rectangle(egalisation, egalisation->histogrammes + (size_t)indice * egalisation->nbr_classes,
+                          0, (int)((long)nbr_ligne * indice / egalisation->nbr_bandes),
+                          acces_nbr_colonne_PNM(egalisation->image), (int)((long)nbr_ligne * (indice+1) / egalisation->nbr_bandes));
+}
+
+static void table_tuile(int indice, void *contexte){
+    Egalisation *egalisation = contexte;
+    int nbr_classes = egalisation->nbr_classes, nbr_x = egalisation->nbr_tuiles_x, nbr_y = egalisation->nbr_tuiles_y;
+    int tx = indice % nbr_x, ty = indice / nbr_x, pas;
+    int nbr_ligne = acces_nbr_ligne_PNM(egalisation->image), nbr_colonne = acces_nbr_colonne_PNM(egalisation->image);
+    int x0 = (int)((long)nbr_colonne * tx / nbr_x), x1 = (int)((long)nbr_colonne * (tx+1) / nbr_x);
+    int y0 = (int)((long)nbr_ligne * ty / nbr_y), y1 = (int)((long)nbr_ligne * (ty+1) / nbr_y);
+    unsigned int *histogramme = egalisation->histogrammes + (size_t)indice * nbr_classes;
+    unsigned short *table = egalisation->tables + (size_t)indice * nbr_classes;
+    unsigned long long nbr_pixels = (unsigned long long)(x1-x0) * (y1-y0), excedent = 0, lot, reste, cumul = 0;
+    unsigned long long hauteur_max;
+
+    histogramme_rectangle(egalisation, histogramme, x0, y0, x1, y1);
+
+    //écrêtage à limite fois la hauteur moyenne d'une classe
+    hauteur_max = (unsigned long long)(egalisation->limite * nbr_pixels / nbr_classes);
+    if(hauteur_max < 1)
+        hauteur_max = 1;
+    for(int k=0; k<nbr_classes; k++){
+        if(histogramme[k] > hauteur_max){
+            excedent += histogramme[k] - hauteur_max;
+            histogramme[k] = (unsigned int)hauteur_max;
+        }
+    }
+
+    //l'excédent est réparti uniformément, le reste une classe sur pas
+    lot = excedent / nbr_classes;
+    reste = excedent - lot * nbr_classes;
+    for(int k=0; k<nbr_classes; k++)
+        histogramme[k] += (unsigned int)lot;
+    if(reste>0){
+        pas = (int)(nbr_classes / reste);
+        for(int k=0; k<nbr_classes && reste>0; k+=pas, reste--)
+            histogramme[k]++;
+    }
+
+    for(int k=0; k<nbr_classes; k++){
+        cumul += histogramme[k];
+        table[k] = (unsigned short)((cumul * egalisation->valeur_max + nbr_pixels / 2) / nbr_pixels);
+    }
+}
+
+static void egalise_tuile(const Tuile *tuile, void *contexte){
+    Egalisation *egalisation = contexte;
+    int nbr_canaux = egalisation->nbr_canaux;
+    unsigned int ancienne;
+    unsigned short *ligne;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        ligne = acces_ligne_PNM(egalisation->image, i);
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++){
+            ancienne = luminance_pixel(&ligne[j*nbr_canaux], egalisation->couleur);
+            remplace_luminance(&ligne[j*nbr_canaux], egalisation, ancienne, egalisation->tables[ancienne]);
+        }
+    }
+}
+
+static void interpole_tuile(const Tuile *tuile, void *contexte){
+    Egalisation *egalisation = contexte;
+    int nbr_canaux = egalisation->nbr_canaux, nbr_classes = egalisation->nbr_classes, nbr_x = egalisation->nbr_tuiles_x;
+    int nbr_ligne = acces_nbr_ligne_PNM(egalisation->image), haut, bas, gauche, droite;
+    const unsigned short *tables_haut, *tables_bas;
+    double position, poids_bas, poids_droite, valeur;
+    unsigned int ancienne;
+    unsigned short *ligne;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        //tuiles dont le centre est au-dessus et au-dessous de la ligne
+        position = (i + 0.5) * egalisation->nbr_tuiles_y / nbr_ligne - 0.5;
+        haut = (int)floor(position);
+        poids_bas = position - haut;
+        if(haut < 0){
+            haut = 0;
+            poids_bas = 0;
+        }
+        if(haut >= egalisation->nbr_tuiles_y-1){
+            haut = egalisation->nbr_tuiles_y-1;
+            poids_bas = 0;
+        }
+        bas = (poids_bas>0) ? haut+1 : haut;
+        tables_haut = egalisation->tables + (size_t)haut * nbr_x * nbr_classes;
+        tables_bas = egalisation->tables + (size_t)bas * nbr_x * nbr_classes;
+
+        ligne = acces_ligne_PNM(egalisation->image, i);
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++){
+            ancienne = luminance_pixel(&ligne[j*nbr_canaux], egalisation->couleur);
+            gauche = egalisation->gauche[j] * nbr_classes + ancienne;
+            poids_droite = egalisation->poids[j];
+            droite = (poids_droite>0) ? gauche + nbr_classes : gauche;
+
+            valeur = (1 - poids_bas) * ((1 - poids_droite) * tables_haut[gauche] + poids_droite * tables_haut[droite])
+                     + poids_bas * ((1 - poids_droite) * tables_bas[gauche] + poids_droite * tables_bas[droite]);
+            remplace_luminance(&ligne[j*nbr_canaux], egalisation, ancienne, (unsigned int)(valeur + 0.5));
+        }
+    }
+}
+
+static void histogramme_rectangle(const Egalisation *egalisation, unsigned int *histogramme, int x0, int y0, int x1, int y1){
+    int nbr_canaux = egalisation->nbr_canaux;
+    unsigned short *ligne;
+
+    memset(histogramme, 0, egalisation->nbr_classes * sizeof(unsigned int));
+    for(int i=y0; i<y1; i++){
+        ligne = acces_ligne_PNM(egalisation->image, i);
+        for(int j=x0; j<x1; j++)
+            histogramme[luminance_pixel(&ligne[j*nbr_canaux], egalisation->couleur)]++;
+    }
+}
+
+//la luminance étant une moyenne pondérée de poids total 1, ajouter l'écart aux trois composantes la déplace d'autant
+static inline void remplace_luminance(unsigned short *pixel, const Egalisation *egalisation, unsigned int ancienne, unsigned int nouvelle){
+    long valeur;
+
+    if(!egalisation->couleur){
+        pixel[0] = (unsigned short)nouvelle;
+        return;
+    }
+    for(int x=0; x<3; x++){
+        valeur = (long)pixel[x] + (long)nouvelle - (long)ancienne;
+        if(valeur < 0)
+            valeur = 0;
+        if(valeur > (long)egalisation->valeur_max)
+            valeur = egalisation->valeur_max;
+        pixel[x] = (unsigned short)valeur;
+    }
+}
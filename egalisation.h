@@ -0,0 +1,82 @@
+/**
+ * \file egalisation.h
+ * \brief Ce fichier contient les prototypes de l'égalisation d'histogramme et de CLAHE pour images PNM.
+ *
+ * Les deux filtres agissent sur la valeur d'une image PGM et sur la luminance
+ * (0.299 r + 0.587 v + 0.114 b) d'une image PPM: la différence entre la
+ * luminance égalisée et la luminance d'origine est ajoutée aux trois
+ * composantes, ce qui conserve les écarts de couleur.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __EGALISATION__
+#define __EGALISATION__
+
+#include "pnm.h"
+
+/**
+ * Paramètres par défaut de CLAHE
+ */
+#define NBR_TUILES_CLAHE 8
+#define LIMITE_CLAHE 2.0
+
+/**
+ * Limite maximale de CLAHE: avec au plus 256 classes, une classe ne dépasse
+ * jamais 256 fois la hauteur moyenne, plus aucune n'est écrêtée au-delà
+ */
+#define LIMITE_MAX_CLAHE 256.0
+
+/**
+ * \fn egalisation_histogramme(PNM *image)
+ * \brief Égalise l'histogramme de l'image entière
+ *
+ * Chaque valeur v devient (cdf(v) - cdf_min) * valeur_max / (n - cdf_min),
+ * arrondi, où cdf est l'histogramme cumulé des n pixels. Les histogrammes de
+ * bandes de lignes sont calculés en parallèle puis additionnés. Une image
+ * constante n'est pas modifiée.
+ *
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ *
+ * \pre image!=NULL
+ * \post valeurs du tableau de pixel modifiées
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pgm ou ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ *
+ */
+int egalisation_histogramme(PNM *image);
+
+/**
+ * \fn clahe(PNM *image, int nbr_tuiles, double limite)
+ * \brief Égalisation adaptative à contraste limité (CLAHE)
+ *
+ * L'image est découpée en nbr_tuiles x nbr_tuiles tuiles. L'histogramme de
+ * chaque tuile est écrêté à limite fois sa hauteur moyenne, l'excédent est
+ * réparti sur toutes les classes, puis l'histogramme cumulé donne la table
+ * de correspondance de la tuile. Les histogrammes et les tables sont
+ * calculés en parallèle, une tâche par tuile; chaque pixel reçoit ensuite
+ * l'interpolation bilinéaire des tables des quatre tuiles dont les centres
+ * l'entourent (deux ou une seule au bord).
+ *
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param nbr_tuiles le nombre de tuiles par ligne et par colonne (réduit à la taille de l'image)
+ * \param limite la hauteur maximale d'une classe, en multiple de la hauteur moyenne
+ *
+ * \pre image!=NULL, nbr_tuiles>=1, 1<=limite<=LIMITE_MAX_CLAHE
+ * \post valeurs du tableau de pixel modifiées
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pgm ou ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ *
+ */
+int clahe(PNM *image, int nbr_tuiles, double limite);
+
+#endif
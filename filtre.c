@@ -7,13 +7,20 @@
  * 
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
+#include <sched.h>
 
 #include "filtre.h"
 #include "pnm.h"
+#include "ordonnanceur.h"
+#include "couleur.h"
 
 /**
  * Déclaration de static int verifie_param_filtre
@@ -21,58 +28,142 @@
  */
 static int verifie_param_filtre(Filtre filtre, char *param, PNM *image);
 
+/**
+ * Noyaux des filtres: chaque noyau traite une ligne (ou une paire de lignes)
+ * contiguë, pour un nombre de canaux et une variante de paramètre fixés.
+ * Le noyau est choisi une seule fois par appel de filtre, les boucles internes
+ * ne contiennent donc aucun test et sont vectorisées par le compilateur en -O3
+ * (les noyaux de gris, qui élargissent trois canaux entrelacés, grâce à
+ * NOYAU_VECTORIEL).
+ * 
+ */
+typedef void (*Noyau_ligne)(unsigned short *ligne, int nbr_colonne, unsigned short param);
+typedef void (*Noyau_paire_lignes)(unsigned short *haut, unsigned short *bas, int nbr_colonne);
+
+static void echange_lignes_inversees_1(unsigned short *haut, unsigned short *bas, int nbr_colonne);
+static void echange_lignes_inversees_3(unsigned short *haut, unsigned short *bas, int nbr_colonne);
+static void echange_lignes(unsigned short *haut, unsigned short *bas, int nbr_valeurs);
+static void negatif_3(unsigned short *ligne, int nbr_colonne, unsigned short valeur_max);
+static void gris_moyenne(unsigned short *ligne, int nbr_colonne, unsigned short param);
+static void gris_luminance(unsigned short *ligne, int nbr_colonne, unsigned short param);
+static void seuillage_1(unsigned short *ligne, int nbr_colonne, unsigned short seuil);
+static void seuillage_3(unsigned short *ligne, int nbr_colonne, unsigned short seuil);
+static void applique_noyau_lignes(PNM *image, Noyau_ligne noyau, unsigned short param);
+static void applique_noyau_tuile(const Tuile *tuile, void *contexte);
+
+/**
+ * \struct Noyau_tuiles
+ * \brief Noyau de ligne appliqué aux tuiles de l'image par l'ordonnanceur
+ */
+typedef struct {
+    PNM *image;
+    Noyau_ligne noyau;
+    unsigned short param;
+} Noyau_tuiles;
+
+/**
+ * Nombre de colonnes traitées entre deux publications de la progression
+ * d'une ligne lors de la diffusion d'erreur
+ */
+#define PAS_PROGRESSION 32
+
+/**
+ * \struct Diffusion_erreur
+ * \brief Etat partagé par les threads d'une diffusion d'erreur en front d'onde
+ * 
+ * Chaque thread traite une ligne sur nbr_threads, le thread appelant
+ * traitant les lignes du thread 0. La ligne i ne traite la colonne j qu'une
+ * fois les colonnes jusqu'à j+2 (j+3 pour Atkinson) de la ligne i-1
+ * traitées: les erreurs qu'elle reçoit sont alors définitives et la ligne
+ * i-1 n'écrit plus dans les cases qu'elle modifie. Seules nbr_threads+3
+ * lignes d'erreur sont conservées, utilisées de façon circulaire.
+ */
+typedef struct {
+    PNM *image;
+    Tramage tramage;
+    int seuil, valeur_max;
+    int nbr_threads;
+    int nbr_tampons, largeur_tampon;
+    int *erreurs;//erreurs accumulées, multipliées par 16
+    int *progression;//nombre de colonnes traitées de chaque ligne
+    int demarrage;//0 pendant la création des threads, 1 une fois tous créés, -1 si une création a échoué
+} Diffusion_erreur;
+
+/**
+ * \struct Thread_diffusion
+ * \brief Argument d'un thread de diffusion d'erreur
+ */
+typedef struct {
+    Diffusion_erreur *diffusion;
+    int premiere_ligne;
+} Thread_diffusion;
+
+static int diffuse_erreur(PNM *image, unsigned int seuil, Tramage tramage);
+static void *diffuse_erreur_lignes(void *arg);
+static void tramage_ordonne(PNM *image, unsigned int seuil);
+static void tramage_ordonne_tuile(const Tuile *tuile, void *contexte);
+
+/**
+ * \struct Tramage_ordonne
+ * \brief Seuils de la matrice de Bayer, partagés par les tuiles d'un tramage ordonné
+ */
+typedef struct {
+    PNM *image;
+    int seuils[8][8];
+} Tramage_ordonne;
+
 
 void retournement(PNM *image){
     assert(image!=NULL);
-    unsigned short ***matrice_pixels = acces_valeurs_pixel_PNM(image);
     int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
-    int format = acces_format_PNM(image);
-    unsigned short tampon[3];
-    for(int i=0; i<nbr_ligne/2; i++){
-        for(int j=0; j<nbr_colonne; j++){
-            if(format==3){
-                for(int x=1; x<3; x++){
-                    tampon[x] = matrice_pixels[i][j][x];
-                    matrice_pixels[i][j][x] = matrice_pixels[nbr_ligne-i-1][nbr_colonne-j-1][x];
-                    matrice_pixels[nbr_ligne-i-1][nbr_colonne-j-1][x] = tampon[x];
-                }
-            }
-            else{
-                tampon[0] = matrice_pixels[i][j][0];
-                matrice_pixels[i][j][0] = matrice_pixels[nbr_ligne-i-1][nbr_colonne-j-1][0];
-                matrice_pixels[nbr_ligne-i-1][nbr_colonne-j-1][0] = tampon[0];
-            }
-        }
-    }
+    Noyau_paire_lignes noyau = (acces_nbr_canaux_PNM(image)==3) ? echange_lignes_inversees_3 : echange_lignes_inversees_1;
+
+    //la ligne i, lue à l'envers, est échangée avec la ligne nbr_ligne-i-1
+    for(int i=0; i<(nbr_ligne+1)/2; i++)
+        noyau(acces_ligne_PNM(image, i), acces_ligne_PNM(image, nbr_ligne-i-1), nbr_colonne);
+}
+
+void miroir_horizontal(PNM *image){
+    assert(image!=NULL);
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
+    Noyau_paire_lignes noyau = (acces_nbr_canaux_PNM(image)==3) ? echange_lignes_inversees_3 : echange_lignes_inversees_1;
+
+    //chaque ligne est échangée avec elle-même, lue à l'envers
+    for(int i=0; i<nbr_ligne; i++)
+        noyau(acces_ligne_PNM(image, i), acces_ligne_PNM(image, i), nbr_colonne);
+}
+
+void miroir_vertical(PNM *image){
+    assert(image!=NULL);
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_valeurs = acces_nbr_colonne_PNM(image) * acces_nbr_canaux_PNM(image);
+
+    for(int i=0; i<nbr_ligne/2; i++)
+        echange_lignes(acces_ligne_PNM(image, i), acces_ligne_PNM(image, nbr_ligne-i-1), nbr_valeurs);
 }
 
 int monochrome(PNM *image, char *couleur){
     assert(couleur!=NULL && image!=NULL);
-    char type_monochrome = couleur[0];
     if(verifie_param_filtre(mono, couleur, image)==-1){
         printf("Le paramètre du filtre monochrome entré est incorrect.\n");
         return -1;
     }
+
+    return monochrome_couleur(image, couleur[0]);
+}
+
+int monochrome_couleur(PNM *image, char couleur){
+    assert(image!=NULL && (couleur=='r' || couleur=='v' || couleur=='b'));
+    char nom[2] = {couleur, '\0'};
+    Matrice_couleur matrice;
+
     if(acces_format_PNM(image)!=3){
         printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour pouvoir y appliquer un filtre monochrome.\n");
         return -2;
     }
-    unsigned short ***matrice_pixels = acces_valeurs_pixel_PNM(image);
-    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
 
-
-    for(int i=0; i<nbr_ligne; i++){
-        for(int j=0; j<nbr_colonne; j++){
-            for(int x=0; x<2; x++){
-                if(type_monochrome=='r' && x!=0)
-                        matrice_pixels[i][j][x]=0;
-                if(type_monochrome=='v' && x!=1)
-                        matrice_pixels[i][j][x]=0;
-                if(type_monochrome=='b' && x!=2)
-                        matrice_pixels[i][j][x]=0;
-            }
-        }
-    }
+    //transformation prédéfinie "r", "v" ou "b": seule la composante choisie est conservée
+    matrice_couleur_predefinie(&matrice, nom);
+    applique_matrice_couleur(image, &matrice);
 
     return 0;
 }
@@ -83,15 +174,8 @@ int negatif(PNM *image){
         printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour pouvoir y appliquer un filtre négatif.\n");
         return -1;
     }
-    unsigned short ***matrice_pixels = acces_valeurs_pixel_PNM(image);
-    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
 
-    for(int i=0; i<nbr_ligne; i++){
-        for(int j=0; j<nbr_colonne; j++){
-            for(int x=0; x<3; x++)
-                matrice_pixels[i][j][x]=255-matrice_pixels[i][j][x];
-        }
-    }
+    applique_noyau_lignes(image, negatif_3, acces_valeur_max_PNM(image));
 
     return 0;
 }
@@ -106,30 +190,20 @@ int gris(PNM *image, char *technique){
         printf("Le paramètre de filtre gris est incorrect.\n");
         return -2;
     }
-    unsigned short ***matrice_pixels = acces_valeurs_pixel_PNM(image);
-    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
-    float moyenne;
-    unsigned short gris[1];
-    changer_format(image, 2);
 
-    for(int i=0; i<nbr_ligne; i++){
-        for(int j=0; j<nbr_colonne; j++){
-            if(atoi(technique)==1){
-                moyenne = 0;
-                for(int x=0; x<3; x++)
-                    moyenne += matrice_pixels[i][j][x];
-                moyenne /= 3;
-            }
-            else
-                moyenne = 0.299 * matrice_pixels[i][j][0] + 0.587 * matrice_pixels[i][j][1] + 0.114 * matrice_pixels[i][j][2];
-            
-            gris[0] = moyenne;
-            if((moyenne - gris[0])>0.5)
-                gris[0]++;
-            
-            changer_valeur_pixel_PNM(image, i, j, gris);
-        }
+    return gris_technique(image, atoi(technique));
+}
+
+int gris_technique(PNM *image, int technique){
+    assert(image!=NULL && (technique==1 || technique==2));
+    if(acces_format_PNM(image)!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour y appliquer un filtre gris.\n");
+        return -1;
     }
+
+    //la valeur grise est écrite dans la première composante de chaque pixel
+    applique_noyau_lignes(image, (technique==1) ? gris_moyenne : gris_luminance, 0);
+    changer_format(image, 2);
     
     return 0;
 }
@@ -146,28 +220,282 @@ int noir_blanc(PNM *image,char *seuil){
         printf("Le seuil entré n'est pas une valeur de seuil valable.\n");
         return -1;
     }
+
+    return noir_blanc_seuil(image, atoi(seuil));
+}
+
+int noir_blanc_seuil(PNM *image, unsigned int seuil){
+    return noir_blanc_tramage(image, seuil, tramage_aucun);
+}
+
+int noir_blanc_tramage(PNM *image, unsigned int seuil, Tramage tramage){
+    assert(image!=NULL);
+    int format;
+    if((format=acces_format_PNM(image))!=2 && format!=3){
+        printf("L'image donnée est déjà en noir et blanc.\n");
+        return -2;
+    }
+    if(seuil>acces_valeur_max_PNM(image)){
+        printf("Le seuil entré n'est pas une valeur de seuil valable.\n");
+        return -1;
+    }
     if(format==3){
-        if(gris(image, "1")==-1)
+        if(gris_technique(image, 1)==-1)
             return -3;
     }
-    unsigned short ***matrice_pixels = acces_valeurs_pixel_PNM(image);
-    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
-    unsigned short noir_blanc[1];
+
+    switch(tramage){
+    case tramage_floyd_steinberg:
+    case tramage_atkinson:
+        if(diffuse_erreur(image, seuil, tramage)==-1){
+            printf("Allocation de mémoire impossible.\n");
+            return -4;
+        }
+        break;
+    case tramage_bayer:
+        tramage_ordonne(image, seuil);
+        break;
+    default:
+        applique_noyau_lignes(image, (acces_nbr_canaux_PNM(image)==3) ? seuillage_3 : seuillage_1, seuil);
+        break;
+    }
     changer_format(image, 1);
 
-    for(int i=0; i<nbr_ligne; i++){
-        for(int j=0; j<nbr_colonne; j++){
-            if(matrice_pixels[i][j][0]>atoi(seuil))
-                noir_blanc[0]=1;
-            else
-                noir_blanc[0]=0;
-            changer_valeur_pixel_PNM(image, i, j, noir_blanc);
+    return 0;
+}
+
+static void applique_noyau_lignes(PNM *image, Noyau_ligne noyau, unsigned short param){
+    Noyau_tuiles noyau_tuiles = {image, noyau, param};
+
+    //les noyaux sont ponctuels: chaque tuile est une suite de morceaux de lignes indépendants
+    execute_tuiles(acces_nbr_ligne_PNM(image), acces_nbr_colonne_PNM(image), 2*acces_nbr_canaux_PNM(image),
+                   applique_noyau_tuile, &noyau_tuiles);
+}
+
+static void applique_noyau_tuile(const Tuile *tuile, void *contexte){
+    Noyau_tuiles *noyau_tuiles = contexte;
+    int nbr_canaux = acces_nbr_canaux_PNM(noyau_tuiles->image);
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++)
+        noyau_tuiles->noyau(acces_ligne_PNM(noyau_tuiles->image, i) + tuile->x*nbr_canaux, tuile->largeur, noyau_tuiles->param);
+}
+
+static inline void echange_lignes_inversees(unsigned short *haut, unsigned short *bas, int nbr_colonne, const int nbr_canaux){
+    unsigned short tampon;
+    //si haut==bas (ligne du milieu), seule la moitié de la ligne est échangée
+    int fin = (haut==bas) ? nbr_colonne/2 : nbr_colonne;
+    for(int j=0; j<fin; j++){
+        for(int x=0; x<nbr_canaux; x++){
+            tampon = haut[j*nbr_canaux+x];
+            haut[j*nbr_canaux+x] = bas[(nbr_colonne-j-1)*nbr_canaux+x];
+            bas[(nbr_colonne-j-1)*nbr_canaux+x] = tampon;
         }
     }
+}
+static void echange_lignes_inversees_1(unsigned short *haut, unsigned short *bas, int nbr_colonne){
+    echange_lignes_inversees(haut, bas, nbr_colonne, 1);
+}
+static void echange_lignes_inversees_3(unsigned short *haut, unsigned short *bas, int nbr_colonne){
+    echange_lignes_inversees(haut, bas, nbr_colonne, 3);
+}
+
+static void echange_lignes(unsigned short *haut, unsigned short *bas, int nbr_valeurs){
+    unsigned short tampon;
+    for(int j=0; j<nbr_valeurs; j++){
+        tampon = haut[j];
+        haut[j] = bas[j];
+        bas[j] = tampon;
+    }
+}
+
+static void negatif_3(unsigned short *ligne, int nbr_colonne, unsigned short valeur_max){
+    for(int j=0; j<3*nbr_colonne; j++)
+        ligne[j] = valeur_max - ligne[j];
+}
+
+//moyenne arrondie: (r+v+b)/3 dont la partie décimale (0, 1/3 ou 2/3) est arrondie au-dessus si > 0.5
+NOYAU_VECTORIEL
+static void gris_moyenne(unsigned short *ligne, int nbr_colonne, unsigned short param){
+    (void)param;
+    for(int j=0; j<nbr_colonne; j++)
+        ligne[3*j] = (ligne[3*j] + ligne[3*j+1] + ligne[3*j+2] + 1) / 3;
+}
+//luminance 0.299 r + 0.587 v + 0.114 b de chaque pixel (voir luminance_couleur)
+NOYAU_VECTORIEL
+static void gris_luminance(unsigned short *ligne, int nbr_colonne, unsigned short param){
+    (void)param;
+    for(int j=0; j<nbr_colonne; j++)
+        ligne[3*j] = luminance_couleur(ligne[3*j], ligne[3*j+1], ligne[3*j+2]);
+}
+
+static inline void seuillage(unsigned short *ligne, int nbr_colonne, unsigned short seuil, const int nbr_canaux){
+    for(int j=0; j<nbr_colonne; j++)
+        ligne[j*nbr_canaux] = (ligne[j*nbr_canaux] > seuil);
+}
+static void seuillage_1(unsigned short *ligne, int nbr_colonne, unsigned short seuil){
+    seuillage(ligne, nbr_colonne, seuil, 1);
+}
+static void seuillage_3(unsigned short *ligne, int nbr_colonne, unsigned short seuil){
+    seuillage(ligne, nbr_colonne, seuil, 3);
+}
 
+static int diffuse_erreur(PNM *image, unsigned int seuil, Tramage tramage){
+    Diffusion_erreur diffusion;
+    Thread_diffusion arguments[NBR_MAX_THREADS];
+    pthread_t threads[NBR_MAX_THREADS];
+    int nbr_ligne = acces_nbr_ligne_PNM(image), i;
+
+    diffusion.image = image;
+    diffusion.tramage = tramage;
+    diffusion.seuil = seuil;
+    diffusion.valeur_max = acces_valeur_max_PNM(image);
+    diffusion.nbr_threads = nombre_threads_disponibles();
+    if(diffusion.nbr_threads > nbr_ligne)
+        diffusion.nbr_threads = nbr_ligne;
+    diffusion.nbr_tampons = diffusion.nbr_threads + 3;
+    diffusion.largeur_tampon = acces_nbr_colonne_PNM(image) + 4;//2 colonnes de marge de chaque côté
+
+    diffusion.erreurs = calloc((size_t)diffusion.nbr_tampons * diffusion.largeur_tampon, sizeof(int));
+    diffusion.progression = calloc(nbr_ligne, sizeof(int));
+    if(diffusion.erreurs==NULL || diffusion.progression==NULL){
+        free(diffusion.erreurs);
+        free(diffusion.progression);
+        return -1;
+    }
+
+    /*le thread appelant traite les lignes du thread 0; les autres attendent que tous soient créés, car chaque
+    ligne dépend de la précédente: si une création échoue, les threads lancés s'arrêtent sans rien traiter
+    et toute l'image est diffusée par le thread appelant*/
+    diffusion.demarrage = 0;
+    for(i=0; i<diffusion.nbr_threads; i++){
+        arguments[i].diffusion = &diffusion;
+        arguments[i].premiere_ligne = i;
+        if(i>0 && pthread_create(&threads[i], NULL, diffuse_erreur_lignes, &arguments[i])!=0)
+            break;
+    }
+    __atomic_store_n(&diffusion.demarrage, (i<diffusion.nbr_threads) ? -1 : 1, __ATOMIC_RELEASE);
+    if(i<diffusion.nbr_threads){
+        for(int k=1; k<i; k++)
+            pthread_join(threads[k], NULL);
+        diffusion.nbr_threads = 1;
+        i = 1;
+    }
+    diffuse_erreur_lignes(&arguments[0]);
+    for(int k=1; k<i; k++)
+        pthread_join(threads[k], NULL);
+
+    free(diffusion.erreurs);
+    free(diffusion.progression);
     return 0;
 }
 
+static void *diffuse_erreur_lignes(void *arg){
+    Thread_diffusion *thread = arg;
+    Diffusion_erreur *diffusion = thread->diffusion;
+    PNM *image = diffusion->image;
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
+    int nbr_canaux = acces_nbr_canaux_PNM(image);
+    int atkinson = (diffusion->tramage==tramage_atkinson);
+    int avance = atkinson ? 4 : 3;//avance minimale de la ligne précédente, en colonnes
+    int *courante, *suivante, *apres_suivante, valeur, erreur, disponible, demarrage;
+    unsigned short *ligne;
+
+    //attente de la création de tous les threads (le thread appelant, premiere_ligne 0, ne l'attend pas)
+    demarrage = (thread->premiere_ligne==0) ? 1 : 0;
+    while(demarrage==0){
+        demarrage = __atomic_load_n(&diffusion->demarrage, __ATOMIC_ACQUIRE);
+        if(demarrage==0)
+            sched_yield();
+    }
+    if(demarrage==-1)
+        return NULL;
+
+    for(int i=thread->premiere_ligne; i<nbr_ligne; i+=diffusion->nbr_threads){
+        ligne = acces_ligne_PNM(image, i);
+        courante = diffusion->erreurs + (size_t)(i % diffusion->nbr_tampons) * diffusion->largeur_tampon + 2;
+        suivante = diffusion->erreurs + (size_t)((i+1) % diffusion->nbr_tampons) * diffusion->largeur_tampon + 2;
+        apres_suivante = diffusion->erreurs + (size_t)((i+2) % diffusion->nbr_tampons) * diffusion->largeur_tampon + 2;
+
+        /*la dernière ligne recevant des erreurs de la ligne i est remise à zéro avant toute écriture:
+        son ancien occupant, la ligne i+2-nbr_tampons (ou i+1-nbr_tampons), est déjà terminé*/
+        memset((atkinson ? apres_suivante : suivante) - 2, 0, diffusion->largeur_tampon * sizeof(int));
+
+        disponible = (i==0) ? nbr_colonne : 0;
+        for(int j=0; j<nbr_colonne; j++){
+            /*attente de la ligne précédente: ses erreurs vers la colonne j doivent être diffusées, et ses prochaines
+            écritures (colonne disponible-1 et suivantes) ne doivent plus toucher les cases j à j+avance-2 écrites ici*/
+            while(disponible < nbr_colonne && disponible < j+avance){
+                disponible = __atomic_load_n(&diffusion->progression[i-1], __ATOMIC_ACQUIRE);
+                if(disponible < nbr_colonne && disponible < j+avance)
+                    sched_yield();
+            }
+
+            valeur = ligne[j*nbr_canaux] + courante[j]/16;
+            ligne[j*nbr_canaux] = (valeur > diffusion->seuil);
+            erreur = valeur - (valeur > diffusion->seuil ? diffusion->valeur_max : 0);
+
+            if(atkinson){//1/8 de l'erreur vers 6 voisins
+                courante[j+1] += 2*erreur;
+                courante[j+2] += 2*erreur;
+                suivante[j-1] += 2*erreur;
+                suivante[j] += 2*erreur;
+                suivante[j+1] += 2*erreur;
+                apres_suivante[j] += 2*erreur;
+            }
+            else{//Floyd-Steinberg: 7/16, 3/16, 5/16, 1/16
+                courante[j+1] += 7*erreur;
+                suivante[j-1] += 3*erreur;
+                suivante[j] += 5*erreur;
+                suivante[j+1] += erreur;
+            }
+
+            if((j+1) % PAS_PROGRESSION == 0)
+                __atomic_store_n(&diffusion->progression[i], j+1, __ATOMIC_RELEASE);
+        }
+        __atomic_store_n(&diffusion->progression[i], nbr_colonne, __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+}
+
+static void tramage_ordonne(PNM *image, unsigned int seuil){
+    //matrice de Bayer 8x8, valeurs de 0 à 63
+    static const int bayer[8][8] = {
+        { 0, 32,  8, 40,  2, 34, 10, 42},
+        {48, 16, 56, 24, 50, 18, 58, 26},
+        {12, 44,  4, 36, 14, 46,  6, 38},
+        {60, 28, 52, 20, 62, 30, 54, 22},
+        { 3, 35, 11, 43,  1, 33,  9, 41},
+        {51, 19, 59, 27, 49, 17, 57, 25},
+        {15, 47,  7, 39, 13, 45,  5, 37},
+        {63, 31, 55, 23, 61, 29, 53, 21}
+    };
+    int valeur_max = acces_valeur_max_PNM(image);
+    Tramage_ordonne tramage;
+
+    //seuil local = seuil décalé de la matrice centrée sur 0, à l'échelle de valeur_max
+    tramage.image = image;
+    for(int i=0; i<8; i++){
+        for(int j=0; j<8; j++)
+            tramage.seuils[i][j] = (int)seuil + ((2*bayer[i][j] + 1 - 64) * valeur_max) / 128;
+    }
+
+    execute_tuiles(acces_nbr_ligne_PNM(image), acces_nbr_colonne_PNM(image), 2*acces_nbr_canaux_PNM(image),
+                   tramage_ordonne_tuile, &tramage);
+}
+
+static void tramage_ordonne_tuile(const Tuile *tuile, void *contexte){
+    Tramage_ordonne *tramage = contexte;
+    int nbr_canaux = acces_nbr_canaux_PNM(tramage->image);
+    unsigned short *ligne;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        ligne = acces_ligne_PNM(tramage->image, i);
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++)
+            ligne[j*nbr_canaux] = (ligne[j*nbr_canaux] > tramage->seuils[i & 7][j & 7]);
+    }
+}
+
 static int verifie_param_filtre(Filtre filtre, char *param, PNM *image){
     assert(param!=NULL&&(filtre==mono||filtre==g||filtre==nb));
     if(filtre==mono){
@@ -177,7 +505,7 @@ static int verifie_param_filtre(Filtre filtre, char *param, PNM *image){
             return 0;
     }
     else if(filtre==g){
-        if(atoi(param)!=1&&atoi(param)==2)
+        if(atoi(param)!=1&&atoi(param)!=2)
             return -1;
         else
             return 0;
@@ -26,6 +26,19 @@ typedef enum
     nb//noir et blanc
 } Filtre;
 
+/**
+ * \enum typedef enum Tramage
+ * \brief Méthode de conversion en noir et blanc
+ * 
+ */
+typedef enum
+{
+    tramage_aucun,//seuillage simple
+    tramage_floyd_steinberg,//diffusion d'erreur de Floyd-Steinberg
+    tramage_atkinson,//diffusion d'erreur d'Atkinson
+    tramage_bayer//tramage ordonné par matrice de Bayer 8x8
+} Tramage;
+
 /**
  * \fn retournement(PNM *image)
  * \brief fait un rotation de 180 degrés de image.
@@ -38,6 +51,30 @@ typedef enum
  */
 void retournement(PNM *image);
 
+/**
+ * \fn miroir_horizontal(PNM *image)
+ * \brief Inverse l'ordre des pixels de chaque ligne de image (miroir gauche-droite)
+ * 
+ * \param image un pointeur sur PNM
+ * 
+ * \pre image != NULL
+ * \post valeur_pixel de image inversée ligne par ligne
+ * 
+ */
+void miroir_horizontal(PNM *image);
+
+/**
+ * \fn miroir_vertical(PNM *image)
+ * \brief Inverse l'ordre des lignes de image (miroir haut-bas)
+ * 
+ * \param image un pointeur sur PNM
+ * 
+ * \pre image != NULL
+ * \post lignes de image inversées
+ * 
+ */
+void miroir_vertical(PNM *image);
+
 /**
  * \fn monochrome(PNM *image, char *couleur)
  * \brief Applique un filtre monochrome sur une image PNM au format ppm
@@ -58,6 +95,24 @@ void retournement(PNM *image);
  */
 int monochrome(PNM *image, char *couleur);
 
+/**
+ * \fn monochrome_couleur(PNM *image, char couleur)
+ * \brief Applique un filtre monochrome dont le paramètre a déjà été vérifié
+ * 
+ * \param image un pointeur sur PNM
+ * \param couleur la composante à conserver ('r','v' ou 'b')
+ * 
+ * \pre image!=NULL, couleur=='r'||couleur=='v'||couleur=='b'
+ * \post toutes les composantes de chaque pixels nulles, 
+ * sauf celle de couleur
+ * 
+ * \return 
+ *       0 Succès \n
+ *      -2 format!=3
+ * 
+ */
+int monochrome_couleur(PNM *image, char couleur);
+
 /**
  * \fn negatif(PNM *image)
  * \brief Applique un filtre négatif sur une image PNM au format ppm
@@ -90,6 +145,23 @@ int negatif(PNM *image);
  */
 int gris(PNM *image, char *technique);
 
+/**
+ * \fn gris_technique(PNM *image, int technique)
+ * \brief Applique un filtre gris dont le paramètre a déjà été vérifié
+ * 
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param technique 1 (moyenne des composantes) ou 2 (luminance)
+ * 
+ * \pre: image!=NULL, technique==1 ou technique==2
+ * \post: image->format=2, valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès de l'application du filtre \n
+ *      -1 Format d'image différent de ppm
+ * 
+ */
+int gris_technique(PNM *image, int technique);
+
 /**
  * \fn noir_blanc(PNM *image, char *seuil)
  * \brief Applique un filtre noir et blanc sur une image PNM au format ppm ou pgm
@@ -109,4 +181,49 @@ int gris(PNM *image, char *technique);
  */
 int noir_blanc(PNM *image, char *seuil);
 
+/**
+ * \fn noir_blanc_seuil(PNM *image, unsigned int seuil)
+ * \brief Applique un filtre noir et blanc dont le seuil a déjà été lu
+ * 
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param seuil valeur au-delà de laquelle un pixel gris vaut 1
+ * 
+ * \pre: image!=NULL
+ * \post: image->format=1, valeurs du tableau de pixel modifiées
+ * 
+ * \return 
+ *       0 Succès de l'application du filtre \n
+ *      -1 seuil > image->valeur_max \n
+ *      -2 Format d'entrée différent de 2(pgm) ou 3(ppm)
+ * 
+ */
+int noir_blanc_seuil(PNM *image, unsigned int seuil);
+
+/**
+ * \fn noir_blanc_tramage(PNM *image, unsigned int seuil, Tramage tramage)
+ * \brief Applique un filtre noir et blanc avec tramage
+ * 
+ * La diffusion d'erreur ne conserve que quelques lignes d'erreur et traite
+ * les lignes en parallèle, en front d'onde: une ligne avance avec trois
+ * colonnes de retard sur la précédente (quatre pour Atkinson), de sorte que
+ * deux lignes n'écrivent jamais la même erreur en même temps. Pour le
+ * tramage de Bayer, seuil est
+ * le seuil moyen autour duquel la matrice répartit les seuils locaux.
+ * 
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param seuil valeur au-delà de laquelle un pixel gris vaut 1
+ * \param tramage méthode de tramage
+ * 
+ * \pre: image!=NULL
+ * \post: image->format=1, valeurs du tableau de pixel modifiées
+ * 
+ * \return 
+ *       0 Succès de l'application du filtre \n
+ *      -1 seuil > image->valeur_max \n
+ *      -2 Format d'entrée différent de 2(pgm) ou 3(ppm) \n
+ *      -4 Erreur d'allocation de mémoire
+ * 
+ */
+int noir_blanc_tramage(PNM *image, unsigned int seuil, Tramage tramage);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,192 @@
+/**
+ * \file flux.c
+ * \brief Ce fichier contient la lecture et le traitement pipeliné de flux d'images PNM.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <ctype.h>
+#include <pthread.h>
+
+#include "flux.h"
+#include "registre.h"
+#include "trace.h"
+#include "pnm.h"
+#include "compression.h"
+
+/**
+ * \struct Flux_PNM_t
+ * \brief Fichier lu image par image
+ */
+struct Flux_PNM_t {
+    FILE *fichier;
+    int entree_standard;
+};
+
+/**
+ * \struct Lecture_flux
+ * \brief Lecture de l'image suivante, faite par un thread pendant le traitement de l'image courante
+ */
+typedef struct {
+    Flux_PNM *flux;
+    PNM **image;
+    int resultat;
+} Lecture_flux;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void *lit_suivante(void *arg);
+static FILE *ouvre_sortie(PNM *image, char *filename_output);
+
+
+Flux_PNM *ouvre_flux_PNM(char *filename){
+    assert(filename!=NULL);
+    Flux_PNM *flux = malloc(sizeof(Flux_PNM));
+    if(flux==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        return NULL;
+    }
+
+    flux->entree_standard = (strcmp(filename, "-")==0);
+    flux->fichier = flux->entree_standard ? stdin : ouvre_fichier_image(filename, "r");
+    if(flux->fichier==NULL){
+        printf("Impossible d'ouvrir le fichier %s.\n", filename);
+        free(flux);
+        return NULL;
+    }
+
+    return flux;
+}
+
+int lit_image_flux(Flux_PNM *flux, PNM **image){
+    assert(flux!=NULL && image!=NULL);
+    Entete_PNM entete;
+    int c;
+
+    //seuls des espacements séparent la dernière valeur d'une image de l'en tête de la suivante
+    do
+        c = getc(flux->fichier);
+    while(c!=EOF && isspace(c));
+    if(c==EOF)
+        return 1;
+    ungetc(c, flux->fichier);
+
+    entete.valeur_max = 1;
+    if(verifie_nombre_magique(&entete.format, flux->fichier)==-1 ||
+       lit_dimensions_image(&entete.nbr_ligne, &entete.nbr_colonne, flux->fichier)==-1 ||
+       ((entete.format==2 || entete.format==3) && lit_valeur_max(&entete.valeur_max, flux->fichier)==-1)){
+        printf("L'en tête d'une image du flux est malformée.\n");
+        return -3;
+    }
+
+    //le stockage de l'image précédente est réutilisé si les dimensions n'ont pas changé
+    if(*image==NULL || reutilise_PNM(*image, entete.nbr_ligne, entete.nbr_colonne, entete.format, entete.valeur_max)!=0){
+        if(*image!=NULL)
+            libere_PNM(image);
+        *image = constructeur_PNM(entete.nbr_ligne, entete.nbr_colonne, entete.format, entete.valeur_max);
+        if(*image==NULL){
+            printf("Allocation de mémoire impossible.\n");
+            return -1;
+        }
+    }
+
+    if(charge_lignes_fichier(*image, flux->fichier)!=0){
+        printf("Erreur lors du chargement d'une image du flux.\n");
+        return -3;
+    }
+
+    return 0;
+}
+
+void ferme_flux_PNM(Flux_PNM **flux){
+    assert(flux!=NULL && *flux!=NULL);
+
+    if(!(*flux)->entree_standard)
+        ferme_fichier_image((*flux)->fichier);
+    free(*flux);
+    *flux = NULL;
+}
+
+int traite_flux_PNM(char *filename, const Filtre_prepare *filtre, char *filename_output){
+    assert(filename!=NULL && filename_output!=NULL);
+    Flux_PNM *flux;
+    PNM *images[2] = {NULL, NULL};
+    Lecture_flux lecture;
+    pthread_t thread;
+    FILE *sortie = NULL;
+    int courant = 0, lance, lu, nbr_images = 0, resultat = 0;
+    unsigned long long trace;
+
+    flux = ouvre_flux_PNM(filename);
+    if(flux==NULL)
+        return -1;
+
+    lu = lit_image_flux(flux, &images[0]);
+    if(lu==1)
+        printf("Le flux %s ne contient aucune image.\n", filename);
+
+    while(lu==0){
+        //l'image suivante est lue dans l'autre stockage pendant le traitement de l'image courante
+        lecture.flux = flux;
+        lecture.image = &images[1-courant];
+        lance = (pthread_create(&thread, NULL, lit_suivante, &lecture)==0);
+        trace = debut_trace();
+
+        if(filtre!=NULL && filtre->descripteur!=NULL && applique_filtre(filtre, images[courant])!=0)
+            resultat = -3;
+        if(resultat==0 && sortie==NULL && (sortie = ouvre_sortie(images[courant], filename_output))==NULL)
+            resultat = -4;
+        if(resultat==0 && (ecrit_en_tete_fichier_PNM(images[courant], sortie)!=0 || ecrit_image_dans_fichier(images[courant], sortie)!=0))
+            resultat = -4;
+        fin_trace("image_flux", trace);
+
+        if(lance)
+            pthread_join(thread, NULL);
+        else
+            lit_suivante(&lecture);
+        if(resultat!=0)
+            break;
+        nbr_images++;
+        lu = lecture.resultat;
+        courant = 1 - courant;
+    }
+    if(resultat==0 && lu<0)
+        resultat = (lu==-1) ? -2 : -1;
+    if(resultat==0 && nbr_images==0)
+        resultat = -1;
+
+    if(sortie!=NULL && ferme_fichier_image(sortie)!=0 && resultat==0)
+        resultat = -4;
+    for(int k=0; k<2; k++){
+        if(images[k]!=NULL)
+            libere_PNM(&images[k]);
+    }
+    ferme_flux_PNM(&flux);
+
+    if(resultat==-4)
+        printf("Un problème est survenu lors de l'écriture de l'image.\n");
+    return (resultat==0) ? nbr_images : resultat;
+}
+
+static void *lit_suivante(void *arg){
+    Lecture_flux *lecture = arg;
+
+    lecture->resultat = lit_image_flux(lecture->flux, lecture->image);
+    return NULL;
+}
+
+static FILE *ouvre_sortie(PNM *image, char *filename_output){
+    if(verifie_validite_filename(filename_output)!=0 || verifie_extension_fichier(filename_output, image)!=0)
+        return NULL;
+    return ouvre_fichier_image(filename_output, "w");
+}
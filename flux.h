@@ -0,0 +1,105 @@
+/**
+ * \file flux.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes de la lecture et du traitement de flux d'images PNM.
+ *
+ * Un flux est une suite d'images PNM (P1 à P3) placées l'une après l'autre
+ * dans un même fichier, un tube nommé ou l'entrée standard, par exemple les
+ * images successives d'une caméra. Les images sont lues une à une, sans
+ * jamais charger le flux entier.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __FLUX__
+#define __FLUX__
+
+#include "pnm.h"
+#include "registre.h"
+
+/**
+ * \struct typedef struct Flux_PNM_t Flux_PNM
+ * \brief Déclaration du type opaque Flux_PNM
+ *
+ */
+typedef struct Flux_PNM_t Flux_PNM;
+
+/**
+ * \fn *ouvre_flux_PNM(char *filename)
+ * \brief Ouvre un flux d'images PNM
+ *
+ * \param filename le fichier ou tube à lire, décompressé s'il se termine par ".gz", "-" pour l'entrée standard
+ *
+ * \pre filename!=NULL
+ * \post /
+ *
+ * \return
+ *      NULL si le flux ne peut être ouvert \n
+ *      un pointeur sur Flux_PNM sinon, à fermer avec ferme_flux_PNM
+ *
+ */
+Flux_PNM *ouvre_flux_PNM(char *filename);
+
+/**
+ * \fn lit_image_flux(Flux_PNM *flux, PNM **image)
+ * \brief Lit l'image suivante du flux
+ *
+ * Si *image n'est pas NULL, son stockage est réutilisé lorsque l'image lue a
+ * les mêmes dimensions et le même nombre de valeurs par pixel; sinon *image
+ * est libérée et remplacée.
+ *
+ * \param flux pointeur sur Flux_PNM
+ * \param image l'adresse d'un pointeur sur PNM, NULL ou une image à réutiliser
+ *
+ * \pre flux!=NULL, image!=NULL
+ * \post si une image est lue, *image la contient
+ *
+ * \return
+ *       0 Une image a été lue \n
+ *       1 Fin du flux \n
+ *      -1 Erreur d'allocation de mémoire \n
+ *      -3 Contenu du flux malformé
+ *
+ */
+int lit_image_flux(Flux_PNM *flux, PNM **image);
+
+/**
+ * \fn ferme_flux_PNM(Flux_PNM **flux)
+ * \brief Ferme un flux (sauf l'entrée standard) et le libère
+ *
+ * \param flux l'adresse d'un pointeur sur Flux_PNM
+ *
+ * \pre flux!=NULL, *flux!=NULL
+ * \post *flux vaut NULL
+ *
+ */
+void ferme_flux_PNM(Flux_PNM **flux);
+
+/**
+ * \fn traite_flux_PNM(char *filename, const Filtre_prepare *filtre, char *filename_output)
+ * \brief Applique filtre à chaque image d'un flux et écrit les résultats, à la suite, dans filename_output
+ *
+ * Le traitement est pipeliné: pendant que l'image k est filtrée et écrite,
+ * un second thread lit l'image k+1. Les deux images alternent entre deux
+ * stockages réutilisés d'une image à l'autre.
+ *
+ * \param filename le flux input, "-" pour l'entrée standard
+ * \param filtre le filtre préparé, NULL pour recopier les images
+ * \param filename_output le fichier output, dont l'extension est adaptée au format de la première image résultat
+ *
+ * \pre filename!=NULL, filename_output!=NULL
+ * \post filename_output contient les images filtrées, dans l'ordre du flux
+ *
+ * \return
+ *      >=0 le nombre d'images traitées \n
+ *      -1 Lecture du flux impossible ou contenu malformé \n
+ *      -2 Erreur d'allocation de mémoire \n
+ *      -3 Le filtre ne peut être appliqué \n
+ *      -4 Écriture de filename_output impossible
+ *
+ */
+int traite_flux_PNM(char *filename, const Filtre_prepare *filtre, char *filename_output);
+
+#endif
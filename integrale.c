@@ -0,0 +1,228 @@
+/**
+ * \file integrale.c
+ * \brief Ce fichier contient les fonctions d'image intégrale et les filtres par fenêtre qui l'utilisent.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+
+#include "integrale.h"
+#include "filtre.h"
+#include "pnm.h"
+#include "ordonnanceur.h"
+
+/**
+ * \struct Integrale_t
+ * \brief Définition du type opaque Integrale
+ * 
+ * sommes[y*(largeur+1)+x] contient la somme des valeurs du rectangle 
+ * [0, x[ x [0, y[; la première ligne et la première colonne sont nulles.
+ */
+struct Integrale_t {
+    int largeur, hauteur;
+    unsigned long long *sommes;
+    unsigned long long *carres;//NULL si les carrés n'ont pas été intégrés
+};
+
+/**
+ * \struct Fenetres_tuiles
+ * \brief Filtre par fenêtre évalué tuile par tuile à partir d'une image intégrale déjà construite
+ */
+typedef struct {
+    PNM *image;
+    Integrale *integrale;
+    int canal, rayon;
+    double k, dynamique;
+    Seuillage_adaptatif methode;
+} Fenetres_tuiles;
+
+/**
+ * Déclaration des fonctions statiques
+ * 
+ */
+static void flou_tuile(const Tuile *tuile, void *contexte);
+static void seuillage_tuile(const Tuile *tuile, void *contexte);
+
+
+Integrale *construit_integrale(PNM *image, int canal, int carres){
+    assert(image!=NULL && canal>=0 && canal<acces_nbr_canaux_PNM(image));
+    int nbr_canaux = acces_nbr_canaux_PNM(image);
+    unsigned long long somme_ligne, carre_ligne, valeur;
+    unsigned long long *sommes, *carres_courants, *precedente, *precedente_carres;
+    unsigned short *ligne;
+
+    Integrale *integrale = malloc(sizeof(Integrale));
+    if(integrale==NULL)
+        return NULL;
+    integrale->largeur = acces_nbr_colonne_PNM(image);
+    integrale->hauteur = acces_nbr_ligne_PNM(image);
+
+    size_t taille = (size_t)(integrale->largeur+1) * (integrale->hauteur+1);
+    integrale->sommes = calloc(taille, sizeof(unsigned long long));
+    integrale->carres = carres ? calloc(taille, sizeof(unsigned long long)) : NULL;
+    if(integrale->sommes==NULL || (carres && integrale->carres==NULL)){
+        libere_integrale(&integrale);
+        return NULL;
+    }
+
+    //chaque case = somme de la ligne jusqu'ici + case de la ligne du dessus
+    for(int i=0; i<integrale->hauteur; i++){
+        ligne = acces_ligne_PNM(image, i);
+        precedente = integrale->sommes + (size_t)i * (integrale->largeur+1);
+        sommes = precedente + integrale->largeur + 1;
+        precedente_carres = carres ? integrale->carres + (size_t)i * (integrale->largeur+1) : NULL;
+        carres_courants = carres ? precedente_carres + integrale->largeur + 1 : NULL;
+        somme_ligne = 0;
+        carre_ligne = 0;
+        for(int j=0; j<integrale->largeur; j++){
+            valeur = ligne[j*nbr_canaux + canal];
+            somme_ligne += valeur;
+            sommes[j+1] = precedente[j+1] + somme_ligne;
+            if(carres){
+                carre_ligne += valeur * valeur;
+                carres_courants[j+1] = precedente_carres[j+1] + carre_ligne;
+            }
+        }
+    }
+
+    return integrale;
+}
+
+void libere_integrale(Integrale **integrale){
+    if(*integrale!=NULL){
+        free((*integrale)->sommes);
+        free((*integrale)->carres);
+        free(*integrale);
+    }
+    *integrale = NULL;
+}
+
+unsigned long long somme_rectangle(Integrale *integrale, int x0, int y0, int x1, int y1){
+    assert(integrale!=NULL);
+    int largeur = integrale->largeur + 1;
+
+    return integrale->sommes[(size_t)y1*largeur + x1] - integrale->sommes[(size_t)y0*largeur + x1]
+         - integrale->sommes[(size_t)y1*largeur + x0] + integrale->sommes[(size_t)y0*largeur + x0];
+}
+
+void moyenne_variance_locale(Integrale *integrale, int x, int y, int rayon, double *moyenne, double *variance){
+    assert(integrale!=NULL && moyenne!=NULL && (variance==NULL || integrale->carres!=NULL));
+    int x0 = x-rayon < 0 ? 0 : x-rayon, y0 = y-rayon < 0 ? 0 : y-rayon;
+    int x1 = x+rayon+1 > integrale->largeur ? integrale->largeur : x+rayon+1;
+    int y1 = y+rayon+1 > integrale->hauteur ? integrale->hauteur : y+rayon+1;
+    int largeur = integrale->largeur + 1;
+    double nbr_valeurs = (double)(x1-x0) * (y1-y0), carres;
+
+    *moyenne = somme_rectangle(integrale, x0, y0, x1, y1) / nbr_valeurs;
+    if(variance!=NULL){
+        carres = (double)(integrale->carres[(size_t)y1*largeur + x1] - integrale->carres[(size_t)y0*largeur + x1]
+               - integrale->carres[(size_t)y1*largeur + x0] + integrale->carres[(size_t)y0*largeur + x0]);
+        *variance = carres / nbr_valeurs - (*moyenne) * (*moyenne);
+        if(*variance < 0)
+            *variance = 0;
+    }
+}
+
+int flou_boite(PNM *image, int rayon){
+    assert(image!=NULL && rayon>=0);
+    int format = acces_format_PNM(image), nbr_composantes = (format==3) ? 3 : 1;
+    Fenetres_tuiles fenetres;
+
+    if(format!=2 && format!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PGM ou PPM pour y appliquer un flou.\n");
+        return -1;
+    }
+
+    /*une image intégrale par composante; chaque valeur ne dépend que de l'intégrale, pas des valeurs voisines,
+    les tuiles peuvent donc être écrites en parallèle*/
+    fenetres.image = image;
+    fenetres.rayon = rayon;
+    for(int x=0; x<nbr_composantes; x++){
+        fenetres.canal = x;
+        fenetres.integrale = construit_integrale(image, x, 0);
+        if(fenetres.integrale==NULL){
+            printf("Allocation de mémoire impossible.\n");
+            return -2;
+        }
+        execute_tuiles(acces_nbr_ligne_PNM(image), acces_nbr_colonne_PNM(image), 2 + 4*sizeof(unsigned long long),
+                       flou_tuile, &fenetres);
+        libere_integrale(&fenetres.integrale);
+    }
+
+    return 0;
+}
+
+static void flou_tuile(const Tuile *tuile, void *contexte){
+    Fenetres_tuiles *fenetres = contexte;
+    int nbr_canaux = acces_nbr_canaux_PNM(fenetres->image);
+    double moyenne;
+    unsigned short *ligne;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        ligne = acces_ligne_PNM(fenetres->image, i);
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++){
+            moyenne_variance_locale(fenetres->integrale, j, i, fenetres->rayon, &moyenne, NULL);
+            ligne[j*nbr_canaux + fenetres->canal] = (unsigned short)(moyenne + 0.5);
+        }
+    }
+}
+
+int seuillage_adaptatif(PNM *image, int rayon, double k, Seuillage_adaptatif methode){
+    assert(image!=NULL && rayon>=0 && k>=0 && k<=K_MAX_SEUILLAGE);
+    int format = acces_format_PNM(image);
+    Fenetres_tuiles fenetres;
+
+    if(format!=2 && format!=3){
+        printf("L'image donnée est déjà en noir et blanc.\n");
+        return -1;
+    }
+    if(format==3 && gris_technique(image, 1)!=0)
+        return -1;
+
+    fenetres.image = image;
+    fenetres.canal = 0;
+    fenetres.rayon = rayon;
+    fenetres.k = k;
+    fenetres.dynamique = acces_valeur_max_PNM(image) / 2.0;
+    fenetres.methode = methode;
+    fenetres.integrale = construit_integrale(image, 0, methode==sauvola);
+    if(fenetres.integrale==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+
+    execute_tuiles(acces_nbr_ligne_PNM(image), acces_nbr_colonne_PNM(image), 2 + 8*sizeof(unsigned long long),
+                   seuillage_tuile, &fenetres);
+    changer_format(image, 1);
+
+    libere_integrale(&fenetres.integrale);
+    return 0;
+}
+
+static void seuillage_tuile(const Tuile *tuile, void *contexte){
+    Fenetres_tuiles *fenetres = contexte;
+    int nbr_canaux = acces_nbr_canaux_PNM(fenetres->image);
+    double moyenne, variance, seuil;
+    unsigned short *ligne;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        ligne = acces_ligne_PNM(fenetres->image, i);
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++){
+            if(fenetres->methode==sauvola){
+                moyenne_variance_locale(fenetres->integrale, j, i, fenetres->rayon, &moyenne, &variance);
+                seuil = moyenne * (1 + fenetres->k * (sqrt(variance) / fenetres->dynamique - 1));
+            }
+            else{
+                moyenne_variance_locale(fenetres->integrale, j, i, fenetres->rayon, &moyenne, NULL);
+                seuil = moyenne * (1 - fenetres->k);
+            }
+            ligne[j*nbr_canaux] = (ligne[j*nbr_canaux] > seuil);
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * \file integrale.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes des fonctions d'image intégrale (table des sommes cumulées) et des filtres qui l'utilisent.
+ * 
+ * La somme des valeurs de n'importe quel rectangle s'obtient en 4 accès à
+ * l'image intégrale: le coût des filtres par fenêtre ne dépend pas du rayon.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+//Include guard
+#ifndef __INTEGRALE__
+#define __INTEGRALE__
+
+#include "pnm.h"
+
+/**
+ * \struct typedef struct Integrale_t Integrale
+ * \brief Déclaration du type opaque Integrale
+ *
+ */
+typedef struct Integrale_t Integrale;
+
+/**
+ * Valeur maximale du paramètre k du seuillage adaptatif: au-delà, le seuil
+ * de Bradley est négatif et tous les pixels deviennent blancs
+ */
+#define K_MAX_SEUILLAGE 1.0
+
+/**
+ * \enum typedef enum Seuillage_adaptatif
+ * \brief Méthode de calcul du seuil local
+ * 
+ */
+typedef enum
+{
+    sauvola,//seuil = moyenne * (1 + k * (écart type / (valeur_max/2) - 1))
+    bradley//seuil = moyenne * (1 - k)
+} Seuillage_adaptatif;
+
+/**
+ * \fn *construit_integrale(PNM *image, int canal, int carres)
+ * \brief Construit l'image intégrale d'une composante de image
+ * 
+ * Les sommes sont accumulées sur 64 bits: aucun débordement, même pour de
+ * très grandes images.
+ * 
+ * \param image pointeur sur PNM
+ * \param canal la composante à intégrer (0 pour PBM et PGM, 0 à 2 pour PPM)
+ * \param carres 1 pour intégrer aussi les carrés des valeurs (variance locale), 0 sinon
+ * 
+ * \pre image!=NULL, 0<=canal<acces_nbr_canaux_PNM(image)
+ * \post /
+ * 
+ * \return
+ *      NULL en cas d'erreur d'allocation \n
+ *      un pointeur sur Integrale sinon
+ * 
+ */
+Integrale *construit_integrale(PNM *image, int canal, int carres);
+
+/**
+ * \fn libere_integrale(Integrale **integrale)
+ * \brief free une image intégrale
+ * 
+ * \param integrale l'adresse d'un pointeur sur Integrale à libérer
+ * 
+ * \pre integrale!=NULL
+ * \post *integrale==NULL
+ * 
+ */
+void libere_integrale(Integrale **integrale);
+
+/**
+ * \fn somme_rectangle(Integrale *integrale, int x0, int y0, int x1, int y1)
+ * \brief Somme des valeurs du rectangle [x0, x1[ x [y0, y1[
+ * 
+ * \param integrale pointeur sur Integrale
+ * \param x0, y0 coin supérieur gauche (inclus)
+ * \param x1, y1 coin inférieur droit (exclu)
+ * 
+ * \pre integrale!=NULL, 0<=x0<=x1<=largeur, 0<=y0<=y1<=hauteur
+ * \post /
+ * 
+ * \return
+ *      la somme des valeurs du rectangle
+ * 
+ */
+unsigned long long somme_rectangle(Integrale *integrale, int x0, int y0, int x1, int y1);
+
+/**
+ * \fn moyenne_variance_locale(Integrale *integrale, int x, int y, int rayon, 
+ * double *moyenne, double *variance)
+ * \brief Moyenne et variance de la fenêtre de rayon donné centrée sur (x, y)
+ * 
+ * La fenêtre est tronquée aux bords de l'image.
+ * 
+ * \param integrale pointeur sur Integrale
+ * \param x, y la colonne et la ligne du centre de la fenêtre
+ * \param rayon le rayon de la fenêtre (côté 2*rayon+1)
+ * \param moyenne pointeur où écrire la moyenne
+ * \param variance pointeur où écrire la variance, NULL si inutile
+ * 
+ * \pre integrale!=NULL, moyenne!=NULL, variance==NULL si integrale construite sans carrés
+ * \post /
+ * 
+ */
+void moyenne_variance_locale(Integrale *integrale, int x, int y, int rayon, double *moyenne, double *variance);
+
+/**
+ * \fn flou_boite(PNM *image, int rayon)
+ * \brief Remplace chaque valeur par la moyenne de la fenêtre de rayon donné
+ * 
+ * \param image pointeur sur PNM auquel appliquer le flou
+ * \param rayon le rayon de la fenêtre
+ * 
+ * \pre image!=NULL, rayon>=0
+ * \post valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pgm ou ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ * 
+ */
+int flou_boite(PNM *image, int rayon);
+
+/**
+ * \fn seuillage_adaptatif(PNM *image, int rayon, double k, Seuillage_adaptatif methode)
+ * \brief Convertit une image en noir et blanc avec un seuil calculé sur la fenêtre de chaque pixel
+ * 
+ * Comme pour noir_blanc, une image PPM est d'abord convertie en gris et
+ * un pixel vaut 1 si sa valeur dépasse son seuil local.
+ * 
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param rayon le rayon de la fenêtre
+ * \param k paramètre de la méthode (typiquement 0.2 à 0.5 pour Sauvola, 0.15 pour Bradley)
+ * \param methode sauvola ou bradley
+ * 
+ * \pre image!=NULL, rayon>=0, 0<=k<=K_MAX_SEUILLAGE
+ * \post image->format=1, valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pgm ou ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ * 
+ */
+int seuillage_adaptatif(PNM *image, int rayon, double k, Seuillage_adaptatif methode);
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * \file lot.c
+ * \brief Ce fichier contient le traitement par lot de plusieurs images, avec lectures anticipées et écritures différées.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "lot.h"
+#include "registre.h"
+#include "trace.h"
+#include "pnm.h"
+#include "compression.h"
+
+/**
+ * \struct Fichier_lot
+ * \brief Image du lot; image n'est accédée que par le thread qui possède le fichier dans son état courant
+ */
+typedef struct {
+    char *filename;
+    char *filename_output;
+    PNM *image;
+    int resultat;//0 tant qu'aucune étape n'a échoué
+    int lue;//1 une fois la lecture terminée (réussie ou non)
+} Fichier_lot;
+
+/**
+ * \struct Lot
+ * \brief État partagé entre le thread appelant et les threads d'entrée/sortie
+ */
+typedef struct {
+    Fichier_lot *fichiers;
+    int nbr_fichiers;
+    int prochaine_lecture, limite_lecture;//les fichiers [prochaine_lecture, limite_lecture[ peuvent être lus
+    int prochaine_ecriture, nbr_filtres;//les fichiers [prochaine_ecriture, nbr_filtres[ attendent leur écriture
+    int nbr_ecrits;
+    int fin;
+    pthread_mutex_t verrou;
+    pthread_cond_t changement;
+} Lot;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void *execute_entrees_sorties(void *arg);
+static void lit_fichier_lot(Fichier_lot *fichier);
+static void filtre_fichier_lot(Fichier_lot *fichier, const Filtre_prepare *filtre, const char *prefixe);
+static void ecrit_fichier_lot(Fichier_lot *fichier);
+static const char *nom_fichier_lot(const char *filename);
+static int memes_noms_sortie(const char *filename_1, const char *filename_2);
+
+
+int traite_lot(char **filenames, int nbr_fichiers, const Filtre_prepare *filtre, const char *prefixe){
+    assert(filenames!=NULL && nbr_fichiers>=0 && filtre!=NULL && filtre->descripteur!=NULL && prefixe!=NULL);
+    Lot lot;
+    pthread_t threads[NBR_THREADS_LOT];
+    int nbr_threads = 0, nbr_echecs = 0;
+    unsigned long long trace;
+
+    //deux résultats écrits dans le même fichier par deux threads d'écriture: le lot est refusé
+    for(int k=0; k<nbr_fichiers; k++){
+        for(int l=k+1; l<nbr_fichiers; l++){
+            if(memes_noms_sortie(filenames[k], filenames[l])){
+                printf("Les images %s et %s produiraient le même fichier output.\n", filenames[k], filenames[l]);
+                return -2;
+            }
+        }
+    }
+
+    lot.fichiers = malloc((nbr_fichiers>0 ? nbr_fichiers : 1) * sizeof(Fichier_lot));
+    if(lot.fichiers==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        return -1;
+    }
+    for(int k=0; k<nbr_fichiers; k++){
+        lot.fichiers[k].filename = filenames[k];
+        lot.fichiers[k].filename_output = NULL;
+        lot.fichiers[k].image = NULL;
+        lot.fichiers[k].resultat = 0;
+        lot.fichiers[k].lue = 0;
+    }
+    lot.nbr_fichiers = nbr_fichiers;
+    lot.prochaine_lecture = lot.prochaine_ecriture = lot.nbr_filtres = lot.nbr_ecrits = 0;
+    lot.limite_lecture = (nbr_fichiers < NBR_LECTURES_LOT + 1) ? nbr_fichiers : NBR_LECTURES_LOT + 1;
+    lot.fin = 0;
+    pthread_mutex_init(&lot.verrou, NULL);
+    pthread_cond_init(&lot.changement, NULL);
+
+    for(int t=0; t<NBR_THREADS_LOT && t<nbr_fichiers; t++){
+        if(pthread_create(&threads[nbr_threads], NULL, execute_entrees_sorties, &lot)==0)
+            nbr_threads++;
+    }
+
+    for(int k=0; k<nbr_fichiers; k++){
+        Fichier_lot *fichier = &lot.fichiers[k];
+
+        //sans thread d'entrée/sortie, chaque image est lue, filtrée et écrite à son tour
+        if(nbr_threads==0){
+            lit_fichier_lot(fichier);
+            filtre_fichier_lot(fichier, filtre, prefixe);
+            ecrit_fichier_lot(fichier);
+            continue;
+        }
+
+        //attente de l'image k, et de la place pour un résultat de plus en attente d'écriture
+        trace = debut_trace();
+        pthread_mutex_lock(&lot.verrou);
+        while(!fichier->lue || lot.nbr_filtres - lot.nbr_ecrits >= NBR_ECRITURES_LOT)
+            pthread_cond_wait(&lot.changement, &lot.verrou);
+        pthread_mutex_unlock(&lot.verrou);
+        fin_trace("attente_lot", trace);
+
+        filtre_fichier_lot(fichier, filtre, prefixe);
+
+        //le résultat est confié aux threads d'entrée/sortie, qui peuvent lire une image de plus
+        pthread_mutex_lock(&lot.verrou);
+        lot.nbr_filtres = k + 1;
+        lot.limite_lecture = (k + 2 + NBR_LECTURES_LOT < nbr_fichiers) ? k + 2 + NBR_LECTURES_LOT : nbr_fichiers;
+        pthread_cond_broadcast(&lot.changement);
+        pthread_mutex_unlock(&lot.verrou);
+    }
+
+    pthread_mutex_lock(&lot.verrou);
+    lot.fin = 1;
+    pthread_cond_broadcast(&lot.changement);
+    pthread_mutex_unlock(&lot.verrou);
+    for(int t=0; t<nbr_threads; t++)
+        pthread_join(threads[t], NULL);
+
+    for(int k=0; k<nbr_fichiers; k++){
+        if(lot.fichiers[k].resultat!=0)
+            nbr_echecs++;
+        free(lot.fichiers[k].filename_output);
+    }
+    pthread_cond_destroy(&lot.changement);
+    pthread_mutex_destroy(&lot.verrou);
+    free(lot.fichiers);
+
+    return nbr_echecs;
+}
+
+static void *execute_entrees_sorties(void *arg){
+    Lot *lot = arg;
+    int k;
+
+    pthread_mutex_lock(&lot->verrou);
+    while(1){
+        //les écritures passent avant les lectures: elles libèrent la mémoire des résultats
+        if(lot->prochaine_ecriture < lot->nbr_filtres){
+            k = lot->prochaine_ecriture++;
+            pthread_mutex_unlock(&lot->verrou);
+            ecrit_fichier_lot(&lot->fichiers[k]);
+            pthread_mutex_lock(&lot->verrou);
+            lot->nbr_ecrits++;
+            pthread_cond_broadcast(&lot->changement);
+        }
+        else if(lot->prochaine_lecture < lot->limite_lecture){
+            k = lot->prochaine_lecture++;
+            pthread_mutex_unlock(&lot->verrou);
+            lit_fichier_lot(&lot->fichiers[k]);
+            pthread_mutex_lock(&lot->verrou);
+            lot->fichiers[k].lue = 1;
+            pthread_cond_broadcast(&lot->changement);
+        }
+        else if(lot->fin)
+            break;
+        else
+            pthread_cond_wait(&lot->changement, &lot->verrou);
+    }
+    pthread_mutex_unlock(&lot->verrou);
+
+    return NULL;
+}
+
+static void lit_fichier_lot(Fichier_lot *fichier){
+    unsigned long long trace = debut_trace();
+
+    if(load_pnm(&fichier->image, fichier->filename)!=0){
+        fichier->image = NULL;
+        fichier->resultat = -1;
+    }
+    fin_trace("lecture_lot", trace);
+}
+
+static void filtre_fichier_lot(Fichier_lot *fichier, const Filtre_prepare *filtre, const char *prefixe){
+    const char *nom;
+
+    if(fichier->resultat!=0)
+        return;
+
+    //le résultat est écrit dans le répertoire courant, sous le nom de l'input précédé du préfixe
+    nom = nom_fichier_lot(fichier->filename);
+    fichier->filename_output = malloc(strlen(prefixe) + strlen(nom) + 1);
+    if(fichier->filename_output==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        fichier->resultat = -1;
+    }
+    else{
+        strcpy(fichier->filename_output, prefixe);
+        strcat(fichier->filename_output, nom);
+        if(applique_filtre(filtre, fichier->image)!=0 || verifie_extension_fichier(fichier->filename_output, fichier->image)!=0)
+            fichier->resultat = -1;
+    }
+
+    if(fichier->resultat!=0)
+        libere_PNM(&fichier->image);
+}
+
+static void ecrit_fichier_lot(Fichier_lot *fichier){
+    unsigned long long trace;
+
+    if(fichier->resultat!=0)
+        return;
+
+    trace = debut_trace();
+    if(write_pnm(fichier->image, fichier->filename_output)==0)
+        printf("Le filtre a correctement été appliqué sur %s et enregistrer dans %s.\n", fichier->filename, fichier->filename_output);
+    else
+        fichier->resultat = -1;
+    libere_PNM(&fichier->image);
+    fin_trace("ecriture_lot", trace);
+}
+
+static const char *nom_fichier_lot(const char *filename){
+    const char *nom = strrchr(filename, '/');
+
+    return (nom!=NULL) ? nom + 1 : filename;
+}
+
+static int memes_noms_sortie(const char *filename_1, const char *filename_2){
+    const char *nom_1 = nom_fichier_lot(filename_1), *nom_2 = nom_fichier_lot(filename_2);
+    int taille = strlen(nom_1), fin_extension = taille;
+
+    if(taille!=(int)strlen(nom_2) || est_compresse(nom_1)!=est_compresse(nom_2))
+        return 0;
+    //les trois lettres de l'extension sont remplacées selon le format du résultat (voir adapte_extension_format)
+    if(est_compresse(nom_1))
+        fin_extension -= 3;
+    for(int i=0; i<taille; i++){
+        if(nom_1[i]!=nom_2[i] && (i<fin_extension-3 || i>=fin_extension))
+            return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file lot.h
+ * \brief Ce fichier contient les prototypes du traitement par lot de plusieurs images.
+ *
+ * Un même filtre est appliqué à une liste d'images. Des threads
+ * d'entrée/sortie lisent les images suivantes et écrivent les résultats déjà
+ * calculés pendant que le thread appelant filtre l'image courante: les
+ * coeurs ne restent pas bloqués sur la latence du stockage (disques réseau).
+ * Le nombre d'images chargées à l'avance et de résultats en attente
+ * d'écriture est borné, ce qui borne la mémoire utilisée.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __LOT__
+#define __LOT__
+
+#include "registre.h"
+
+/**
+ * Nombre de threads d'entrée/sortie
+ */
+#define NBR_THREADS_LOT 4
+
+/**
+ * Nombre maximal d'images lues à l'avance, en plus de l'image filtrée
+ */
+#define NBR_LECTURES_LOT 4
+
+/**
+ * Nombre maximal de résultats filtrés en attente ou en cours d'écriture
+ */
+#define NBR_ECRITURES_LOT 4
+
+/**
+ * \fn traite_lot(char **filenames, int nbr_fichiers, const Filtre_prepare *filtre, const char *prefixe)
+ * \brief Applique filtre à chaque image de filenames et écrit chaque résultat dans le répertoire courant
+ *
+ * Le résultat de "repertoire/image.ppm" est écrit dans prefixe suivi de
+ * "image.ppm", dont l'extension est adaptée au format du résultat (un
+ * suffixe ".gz" est conservé). Une image qui ne peut être lue, filtrée ou
+ * écrite n'interrompt pas le traitement des autres. Le lot est refusé avant
+ * tout traitement si deux images produiraient le même fichier output (même
+ * nom dans deux répertoires, ou extensions adaptées au même format).
+ *
+ * \param filenames les images input
+ * \param nbr_fichiers le nombre d'images input
+ * \param filtre le filtre préparé
+ * \param prefixe le préfixe des noms des images output, sans caractère interdit
+ *
+ * \pre filenames!=NULL, nbr_fichiers>=0, filtre!=NULL, filtre->descripteur!=NULL, prefixe!=NULL
+ * \post les résultats des images traitées avec succès sont écrits
+ *
+ * \return
+ *      >=0 le nombre d'images qui n'ont pas pu être traitées \n
+ *      -1 Erreur d'allocation de mémoire \n
+ *      -2 Deux images produiraient le même fichier output
+ *
+ */
+int traite_lot(char **filenames, int nbr_fichiers, const Filtre_prepare *filtre, const char *prefixe);
+
+#endif
@@ -13,9 +13,25 @@
 #include <ctype.h>
 #include <getopt.h>
 #include <string.h>
+#include <errno.h>
+#include <limits.h>
 
 #include "pnm.h"
 #include "filtre.h"
+#include "registre.h"
+#include "couleur.h"
+#include "integrale.h"
+#include "comparaison.h"
+#include "cache.h"
+#include "planification.h"
+#include "egalisation.h"
+#include "quantification.h"
+#include "bilateral.h"
+#include "composition.h"
+#include "derivation.h"
+#include "flux.h"
+#include "trace.h"
+#include "lot.h"
 
 
 int main(int argc, char *argv[]) {
@@ -26,16 +42,58 @@ int main(int argc, char *argv[]) {
    *  -p [paramètre]
    *  -o image output
    *  -h -> help
+   *  -v -> mode verbeux (affiche le plan d'exécution)
+   *  --info[=json] -> affiche les informations de l'en tête de l'image input
+   *  --roi x,y,l,h -> applique le filtre uniquement au rectangle donné
+   *  --compare image -> compare l'image obtenue (filtrée si -f est donné) à une image de référence
+   *  --cache repertoire[,taille] -> réutilise le résultat d'une exécution identique (taille max en Mo)
+   *  --max-memory taille[k|M|G] -> traite l'image par bandes si elle ne tient pas dans ce budget
+   *  --second image -> seconde image (ou masque PBM) combinée à l'image obtenue par --compose
+   *  --compose operation -> melange[,alpha], difference, minimum, maximum ou masque
+   *  --derive filtre[:parametre]=image -> écrit aussi le résultat d'un autre filtre sur l'image chargée (répétable)
+   *  --stream -> l'input est une suite d'images (fichier, tube ou - pour l'entrée standard), filtrées une à une
+   *  --batch prefixe -> applique le filtre à chaque image donnée après les options, résultats préfixés dans le répertoire courant
+   *  --trace fichier.json -> enregistre la durée de chaque étape par thread (format Chrome / Perfetto)
    */
-   char *optstring = "i:f:p:o:h";
-   PNM *image;
+   char *optstring = "i:f:p:o:hv";
+   struct option options_longues[] = {
+      {"info", optional_argument, NULL, 'I'},
+      {"roi", required_argument, NULL, 'R'},
+      {"compare", required_argument, NULL, 'C'},
+      {"cache", required_argument, NULL, 'K'},
+      {"max-memory", required_argument, NULL, 'M'},
+      {"second", required_argument, NULL, 'S'},
+      {"compose", required_argument, NULL, 'O'},
+      {"derive", required_argument, NULL, 'D'},
+      {"stream", no_argument, NULL, 'F'},
+      {"batch", required_argument, NULL, 'B'},
+      {"trace", required_argument, NULL, 'T'},
+      {"verbose", no_argument, NULL, 'v'},
+      {NULL, 0, NULL, 0}
+   };
+   PNM *image, *cible, *reference, *seconde;
+   Entete_PNM entete;
+   Filtre_prepare filtre_prepare;
+   Comparaison_PNM comparaison;
+   Plan_execution plan;
    int option[4]={0};
-   char *filename=NULL, *filtre=NULL, *parametre=NULL, *filename_output=NULL;
-   int val, erreur_filtre=0;
+   char *filename=NULL, *filtre=NULL, *parametre=NULL, *filename_output=NULL, *format_info=NULL, *roi=NULL, *filename_reference=NULL, *repertoire_cache=NULL, *filename_second=NULL, *composition=NULL, *separateur, *fin_taille;
+   int val, erreur_filtre=0, mode_info=0;
+   int rectangle[4];
+   char cle[TAILLE_CLE_CACHE];
+   unsigned long taille_cache=TAILLE_CACHE_DEFAUT;
+   int cache_actif=0, verbeux=0;
+   unsigned long long budget_memoire=0;
+   Operation_composition operation;
+   double alpha;
+   Derivation derivations[NBR_MAX_DERIVATIONS];
+   int nbr_derivations=0;
+   int mode_flux=0, nbr_images;
+   char *prefixe_lot=NULL;
 
    
 
-   while((val=getopt(argc, argv, optstring))!=EOF){
+   while((val=getopt_long(argc, argv, optstring, options_longues, NULL))!=EOF){
       switch (val){
          case 'i':
             filename=optarg;
@@ -53,8 +111,91 @@ int main(int argc, char *argv[]) {
             option[2]=1;
             filename_output=optarg;
             break;
+         case 'I':
+            mode_info=1;
+            format_info=optarg;
+            break;
+         case 'R':
+            roi=optarg;
+            break;
+         case 'C':
+            filename_reference=optarg;
+            break;
+         case 'K':
+            repertoire_cache=optarg;
+            break;
+         case 'M':
+            if(lit_taille_memoire(optarg, &budget_memoire)!=0){
+               printf("Le budget mémoire %s est incorrect.\n", optarg);
+               return -1;
+            }
+            break;
+         case 'S':
+            filename_second=optarg;
+            break;
+         case 'O':
+            composition=optarg;
+            if(lit_composition(composition, &operation, &alpha)!=0){
+               printf("L'opération de composition %s est incorrecte.\n", composition);
+               return -1;
+            }
+            break;
+         case 'D':
+            if(nbr_derivations==NBR_MAX_DERIVATIONS){
+               printf("Au plus %d dérivations peuvent être demandées.\n", NBR_MAX_DERIVATIONS);
+               return -1;
+            }
+            switch(lit_derivation(optarg, &derivations[nbr_derivations])){
+               case -1:
+                  printf("Le filtre %s ne correspond à aucun filtre.\n", optarg);
+                  return -1;
+               case -2:
+                  printf("Paramètre nécessaire pour l'application du filtre %s.\n", optarg);
+                  return -1;
+               case -3:
+                  printf("Le paramètre du filtre %s est incorrect.\n", optarg);
+                  return -1;
+               case -4:
+                  printf("La dérivation %s doit être de la forme <filtre>[:<paramètre>]=<image_output>.\n", optarg);
+                  return -1;
+               default:
+                  break;
+            }
+            nbr_derivations++;
+            break;
+         case 'F':
+            mode_flux=1;
+            break;
+         case 'B':
+            prefixe_lot=optarg;
+            break;
+         case 'T':
+            //les traces sont écrites à la sortie du programme, quel que soit son code de retour
+            if(active_trace(optarg)!=0){
+               printf("Impossible d'activer les traces.\n");
+               return -1;
+            }
+            break;
+         case 'v':
+            verbeux=1;
+            break;
          case 'h':
-            printf("-i <image_input> -f <filtre> [-p <parametre>] -o <image_output>\n");
+            printf("-i <image_input> -f <filtre> [-p <parametre>] [--roi x,y,l,h] [--cache <répertoire>[,<taille en Mo>]] [--max-memory <taille>[k|M|G]] [--trace <fichier.json>] [-v] -o <image_output>\n");
+            printf("-i <image_input> [-f <filtre> [-p <parametre>]] --second <image_2> --compose melange[,<alpha>]|difference|minimum|maximum|masque -o <image_output>\n");
+            printf("-i <image_input> --derive <filtre>[:<parametre>]=<image_output> [--derive ...] [-f <filtre> [-p <parametre>] -o <image_output>]\n");
+            printf("-i <flux_input>|- -f <filtre> [-p <parametre>] --stream -o <image_output> (images successives d'un même flux)\n");
+            printf("-f <filtre> [-p <parametre>] --batch <préfixe> <image_input> [<image_input> ...] (résultats <préfixe><nom de l'input> dans le répertoire courant)\n");
+            printf("-i <image_input> --info[=json]\n");
+            printf("-i <image_input> [-f <filtre> [-p <parametre>]] [-o <image_output>] --compare <image_reference> (code de retour 1 si les images diffèrent)\n");
+            printf("filtres retournement|miroir_horizontal|miroir_vertical: sans paramètre (en bandes sous --max-memory, input non compressé)\n");
+            printf("filtre NB: -p <seuil>[,seuil|fs|atkinson|bayer]\n");
+            printf("filtre matrice: -p sepia|ycbcr|ycbcr_inverse|r|v|b|rbv|vrb|vbr|brv|bvr|<12 coefficients (au plus %d en valeur absolue)>\n", COEFFICIENT_MAX_MATRICE);
+            printf("filtre teinte: -p <degrés>[,<facteur de saturation (0 à %d)>]\n", SATURATION_MAX_TEINTE);
+            printf("filtres flou|median: -p <rayon>, sauvola|bradley: -p <rayon>[,<k (0 à %.0f)>]\n", K_MAX_SEUILLAGE);
+            printf("filtres erosion|dilatation|ouverture|fermeture (PBM): -p <largeur>[,<hauteur>]\n");
+            printf("filtre egalisation: sans paramètre, clahe: [-p <tuiles par côté>[,<limite (1 à %.0f)>]] (défaut %d,%.1f)\n", LIMITE_MAX_CLAHE, NBR_TUILES_CLAHE, LIMITE_CLAHE);
+            printf("filtre bilateral: -p <sigma spatial>[,<sigma intensité>] (défaut %.0f %% de la valeur max)\n", SIGMA_INTENSITE_BILATERAL * 100);
+            printf("filtre quantification (PPM): -p <couleurs (2 à %d)>[,median|kmoyennes][,fs]\n", NBR_MAX_COULEURS);
             return 0;
 
          default:
@@ -62,64 +203,261 @@ int main(int argc, char *argv[]) {
       }
    }
 
-   for(int i=0; i<3; i++){
-      if(option[i]==0){
-         printf("Option(s) manquante(s). Option h -> help.\n");
+   //mode information: seul l'en tête de l'image est lu
+   if(mode_info){
+      if(option[0]==0){
+         printf("Option -i nécessaire pour afficher les informations d'une image.\n");
+         return -1;
+      }
+      if(format_info!=NULL && strcmp(format_info, "json")!=0){
+         printf("Format d'information inconnu: %s.\n", format_info);
+         return -1;
+      }
+      if(lit_en_tete_PNM(&entete, filename)!=0)
+         return -1;
+      //position et taille sont indisponibles pour un fichier compressé (-1)
+      if(format_info!=NULL){
+         printf("{\"format\": \"P%d\", \"largeur\": %d, \"hauteur\": %d, \"valeur_max\": %u, ",
+                entete.format, entete.nbr_colonne, entete.nbr_ligne, entete.valeur_max);
+         if(entete.position_valeurs<0)
+            printf("\"position_valeurs\": null, \"taille_fichier\": null}\n");
+         else
+            printf("\"position_valeurs\": %ld, \"taille_fichier\": %ld}\n", entete.position_valeurs, entete.taille_fichier);
+      }
+      else{
+         printf("format: P%d\nlargeur: %d\nhauteur: %d\nvaleur max: %u\n",
+                entete.format, entete.nbr_colonne, entete.nbr_ligne, entete.valeur_max);
+         if(entete.position_valeurs<0)
+            printf("position des valeurs: indisponible (fichier compressé)\ntaille du fichier: indisponible (fichier compressé)\n");
+         else
+            printf("position des valeurs: %ld\ntaille du fichier: %ld\n", entete.position_valeurs, entete.taille_fichier);
       }
+      return 0;
    }
 
-   if(load_pnm(&image, filename)!=0)
+   if(mode_flux && (roi!=NULL || filename_reference!=NULL || composition!=NULL || nbr_derivations>0 || repertoire_cache!=NULL ||
+                    budget_memoire>0 || (filtre!=NULL && strcmp(filtre, "recadrage")==0))){
+      printf("L'option --stream ne peut être combinée qu'à un filtre autre que recadrage et à -o.\n");
       return -1;
-   
-   if(strcmp(filtre, "retournement")==0)
-      retournement(image);
-   else if(strcmp(filtre, "monochrome")==0){
-      if(option[3]==0){
-         printf("Paramètre nécessaire pour l'application du filtre monochrome.\n");
-         erreur_filtre=1;
+   }
+
+   //lot: les images suivantes sont lues et les résultats écrits pendant le filtrage de l'image courante
+   if(prefixe_lot!=NULL){
+      if(option[0] || option[2] || mode_flux || roi!=NULL || filename_reference!=NULL || composition!=NULL || nbr_derivations>0 ||
+         repertoire_cache!=NULL || budget_memoire>0 || filtre==NULL || strcmp(filtre, "recadrage")==0){
+         printf("L'option --batch nécessite un filtre autre que recadrage et ne peut être combinée qu'à -p.\n");
+         return -1;
       }
-      else if(monochrome(image, parametre)!=0)
-         erreur_filtre=1;
+      if(optind==argc || verifie_validite_filename(prefixe_lot)!=0){
+         printf("L'option --batch nécessite un préfixe sans caractère interdit et au moins une image input.\n");
+         return -1;
+      }
+      switch(prepare_filtre(&filtre_prepare, filtre, option[3] ? parametre : NULL)){
+         case -1:
+            printf("Le filtre entré en argument ne correspond à aucun filtre.\n");
+            return -1;
+         case -2:
+            printf("Paramètre nécessaire pour l'application du filtre %s.\n", filtre);
+            return -1;
+         case -3:
+            printf("Le paramètre du filtre %s est incorrect.\n", filtre);
+            return -1;
+         default:
+            break;
+      }
+      nbr_images = traite_lot(&argv[optind], argc-optind, &filtre_prepare, prefixe_lot);
+      if(nbr_images!=0){
+         if(nbr_images>0)
+            printf("%d image(s) sur %d n'ont pas pu être traitées.\n", nbr_images, argc-optind);
+         return -1;
+      }
+      return 0;
    }
-   else if(strcmp(filtre, "negatif")==0){
-      if(negatif(image)!=0)
-         erreur_filtre=1;
+
+   if((filename_second==NULL) != (composition==NULL)){
+      printf("Les options --second et --compose doivent être données ensemble.\n");
+      return -1;
    }
-   else if(strcmp(filtre, "gris")==0){
-      if(option[3]==0){
-         printf("Paramètre nécessaire pour l'application du filtre gris.\n");
-         erreur_filtre=1;
+
+   /*en mode comparaison, le filtre et l'image output sont facultatifs; en mode composition, le filtre l'est;
+   avec des dérivations, ils le sont aussi mais vont ensemble*/
+   for(int i=0; i<3; i++){
+      if(option[i]==0 && (i==0 || (filename_reference==NULL && (i==2 || composition==NULL)
+                                   && (nbr_derivations==0 || option[1]!=0 || option[2]!=0)))){
+         printf("Option(s) manquante(s). Option h -> help.\n");
+         return -1;
       }
-      else if(gris(image, parametre)!=0)
-         erreur_filtre=1;
    }
-   else if(strcmp(filtre, "NB")==0){
-      if(option[3]==0){
-         printf("Paramètre nécessaire pour l'application du filtre noir et blanc.\n");
-         erreur_filtre=1;
+
+   //cache: le résultat d'une exécution identique est copié sans charger l'image (la clé ne couvre pas la seconde image)
+   if(repertoire_cache!=NULL && filename_reference==NULL && composition==NULL && nbr_derivations==0){
+      separateur=strchr(repertoire_cache, ',');
+      if(separateur!=NULL){
+         *separateur='\0';
+         //taille en Mo: entier sans signe (ni espace ni '-') dont la conversion en octets ne déborde pas
+         errno = 0;
+         taille_cache = strtoul(separateur+1, &fin_taille, 10);
+         if(fin_taille==separateur+1 || *fin_taille!='\0' || errno!=0 || !isdigit((unsigned char)separateur[1]) ||
+            taille_cache > (ULONG_MAX >> 20)){
+            printf("La taille du cache %s est incorrecte.\n", separateur+1);
+            return -1;
+         }
+         taille_cache <<= 20;
       }
-      else if(noir_blanc(image, parametre)!=0)
-         erreur_filtre=1;
+      if(cle_cache(cle, filename, filtre, option[3] ? parametre : NULL, roi)==0){
+         if(cherche_cache(repertoire_cache, cle, filename_output)==0){
+            printf("Le résultat du filtre sur %s a été trouvé dans le cache et enregistré dans %s.\n", filename, filename_output);
+            return 0;
+         }
+         cache_actif=1;
+      }
+   }
+
+   //recadrage: seule la fenêtre demandée est lue dans le fichier
+   if(filtre!=NULL && strcmp(filtre, "recadrage")==0){
+      if(option[3]==0 || sscanf(parametre, "%d,%d,%d,%d", &rectangle[0], &rectangle[1], &rectangle[2], &rectangle[3])!=4){
+         printf("Paramètre x,y,l,h nécessaire pour l'application du recadrage.\n");
+         return -1;
+      }
+      if(load_pnm_fenetre(&image, filename, rectangle[0], rectangle[1], rectangle[2], rectangle[3])!=0)
+         return -1;
+      filtre_prepare.descripteur=NULL;
    }
    else{
-      printf("Le filtre entré en argument ne correspond à aucun filtre.\n");
-      libere_PNM(&image);
-      return -1;
+      //le filtre et son paramètre sont préparés avant le chargement de l'image
+      filtre_prepare.descripteur=NULL;
+      if(filtre!=NULL){
+         switch(prepare_filtre(&filtre_prepare, filtre, option[3] ? parametre : NULL)){
+            case -1:
+               printf("Le filtre entré en argument ne correspond à aucun filtre.\n");
+               return -1;
+            case -2:
+               printf("Paramètre nécessaire pour l'application du filtre %s.\n", filtre);
+               return -1;
+            case -3:
+               printf("Le paramètre du filtre %s est incorrect.\n", filtre);
+               return -1;
+            default:
+               break;
+         }
+      }
+
+      //flux: les images sont lues, filtrées et écrites une à une, la lecture de la suivante pendant le filtrage
+      if(mode_flux){
+         nbr_images = traite_flux_PNM(filename, &filtre_prepare, filename_output);
+         if(nbr_images<0)
+            return -1;
+         printf("Le filtre a correctement été appliqué sur les %d images de %s et enregistrer dans %s.\n", nbr_images, filename, filename_output);
+         return 0;
+      }
+
+      //planification: l'image est traitée par bandes si son chargement complet dépasse le budget mémoire
+      if(budget_memoire>0 || verbeux){
+         if(lit_en_tete_PNM(&entete, filename)!=0)
+            return -1;
+         switch(planifie_execution(&plan, &entete, filtre_prepare.descripteur!=NULL ? &filtre_prepare : NULL,
+                                   roi==NULL && filename_reference==NULL && composition==NULL && nbr_derivations==0, budget_memoire)){
+            case -1:
+               printf("Aucun traitement de %s ne respecte le budget mémoire.\n", filename);
+               return -1;
+            case -2:
+               printf("Ce traitement nécessite l'image entière en mémoire (%.1f Mo estimés), ce qui dépasse le budget.\n", plan.memoire_estimee / 1048576.0);
+               return -1;
+            default:
+               break;
+         }
+         if(verbeux)
+            affiche_plan(&plan, budget_memoire);
+         if(plan.mode!=execution_memoire){
+            if(execute_plan_bandes(&plan, &filtre_prepare, filename, filename_output)!=0)
+               return -1;
+            printf("Le filtre a correctement été appliqué sur %s et enregistrer dans %s.\n", filename, filename_output);
+            if(cache_actif && ajoute_cache(repertoire_cache, cle, filename_output, taille_cache)!=0)
+               printf("Le résultat n'a pas pu être ajouté au cache %s.\n", repertoire_cache);
+            return 0;
+         }
+      }
+
+      if(load_pnm(&image, filename)!=0)
+         return -1;
+   }
+
+   //dérivations: chaque filtre travaille sur sa copie de l'image chargée, qui n'est pas modifiée
+   if(nbr_derivations>0){
+      if(execute_derivations(image, derivations, nbr_derivations)!=0){
+         libere_PNM(&image);
+         return -1;
+      }
+      if(filename_output==NULL && filename_reference==NULL){
+         libere_PNM(&image);
+         return 0;
+      }
+   }
+
+   //région d'intérêt: le filtre est appliqué à une vue partageant les valeurs de image
+   cible=image;
+   if(roi!=NULL){
+      if(sscanf(roi, "%d,%d,%d,%d", &rectangle[0], &rectangle[1], &rectangle[2], &rectangle[3])!=4 ||
+         (cible=vue_PNM(image, rectangle[0], rectangle[1], rectangle[2], rectangle[3]))==NULL){
+         printf("La région d'intérêt %s n'est pas valable pour cette image.\n", roi);
+         libere_PNM(&image);
+         return -1;
+      }
+   }
+   
+   if(filtre_prepare.descripteur!=NULL && applique_filtre(&filtre_prepare, cible)!=0)
+      erreur_filtre=1;
+   if(cible!=image){
+      if(erreur_filtre==0 && harmonise_vue_PNM(cible, image)!=0)
+         erreur_filtre=1;
+      libere_PNM(&cible);
    }
    if(erreur_filtre==1){
       libere_PNM(&image);
       return -1;
    }
 
+   //composition: la seconde image est combinée à l'image filtrée, qui reçoit le résultat
+   if(composition!=NULL){
+      if(load_pnm(&seconde, filename_second)!=0){
+         libere_PNM(&image);
+         return -1;
+      }
+      erreur_filtre = compose_PNM(image, seconde, operation, alpha);
+      libere_PNM(&seconde);
+      if(erreur_filtre!=0){
+         libere_PNM(&image);
+         return -1;
+      }
+   }
+
 
-   if(verifie_extension_fichier(filename_output, image)==0){
-      if(write_pnm(image, filename_output)==0)
+   if(filename_output!=NULL && verifie_extension_fichier(filename_output, image)==0){
+      if(write_pnm(image, filename_output)==0){
          printf("Le filtre a correctement été appliqué sur %s et enregistrer dans %s.\n", filename, filename_output);
+         if(cache_actif && ajoute_cache(repertoire_cache, cle, filename_output, taille_cache)!=0)
+            printf("Le résultat n'a pas pu être ajouté au cache %s.\n", repertoire_cache);
+      }
       else{
          libere_PNM(&image);
          return -1;
       }
    }
+
+   //comparaison: code de retour 0 si les images sont identiques, 1 sinon
+   if(filename_reference!=NULL){
+      if(load_pnm(&reference, filename_reference)!=0){
+         libere_PNM(&image);
+         return -1;
+      }
+      erreur_filtre = compare_PNM(reference, image, &comparaison);
+      libere_PNM(&reference);
+      libere_PNM(&image);
+      if(erreur_filtre!=0)
+         return -1;
+      affiche_comparaison(&comparaison);
+      return comparaison.ecart_max_global==0 ? 0 : 1;
+   }
    
 
    libere_PNM(&image);
@@ -0,0 +1,185 @@
+/**
+ * \file median.c
+ * \brief Ce fichier contient le filtre médian en temps constant pour images PNM.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "median.h"
+#include "pnm.h"
+
+/**
+ * Largeur minimale (en colonnes) d'une bande traitée par un thread
+ */
+#define LARGEUR_MIN_BANDE 64
+
+/**
+ * \struct Bande_median
+ * \brief Bande de colonnes [premiere_colonne, derniere_colonne[ filtrée par un thread
+ */
+typedef struct {
+    PNM *image;
+    const unsigned short *source;//copie de la composante filtrée, ligne après ligne
+    int canal, rayon, nbr_classes;
+    int premiere_colonne, derniere_colonne;
+    int erreur;
+} Bande_median;
+
+/**
+ * Déclaration des fonctions statiques
+ * 
+ */
+static void *filtre_bande_median(void *arg);
+static inline int borne(int valeur, int min, int max);
+
+
+int median(PNM *image, int rayon){
+    assert(image!=NULL && rayon>=0 && rayon<=32767);
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image);
+    int format = acces_format_PNM(image), nbr_canaux = acces_nbr_canaux_PNM(image);
+    int nbr_composantes = (format==3) ? 3 : 1, nbr_bandes, erreur = 0;
+    Bande_median bandes[NBR_MAX_THREADS];
+    pthread_t threads[NBR_MAX_THREADS];
+    int lance[NBR_MAX_THREADS];
+    unsigned short *source, *ligne;
+
+    if(format!=2 && format!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PGM ou PPM pour y appliquer un filtre médian.\n");
+        return -1;
+    }
+
+    source = malloc((size_t)nbr_ligne * nbr_colonne * sizeof(unsigned short));
+    if(source==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+
+    nbr_bandes = nombre_threads_disponibles();
+    if(nbr_bandes > nbr_colonne / LARGEUR_MIN_BANDE)
+        nbr_bandes = nbr_colonne / LARGEUR_MIN_BANDE;
+    if(nbr_bandes < 1)
+        nbr_bandes = 1;
+
+    for(int x=0; x<nbr_composantes && !erreur; x++){
+        //les médianes sont calculées sur une copie de la composante, puis écrites directement dans image
+        for(int i=0; i<nbr_ligne; i++){
+            ligne = acces_ligne_PNM(image, i);
+            for(int j=0; j<nbr_colonne; j++)
+                source[(size_t)i*nbr_colonne + j] = ligne[j*nbr_canaux + x];
+        }
+
+        for(int b=0; b<nbr_bandes; b++){
+            bandes[b].image = image;
+            bandes[b].source = source;
+            bandes[b].canal = x;
+            bandes[b].rayon = rayon;
+            bandes[b].nbr_classes = acces_valeur_max_PNM(image) + 1;
+            bandes[b].premiere_colonne = (int)((long)nbr_colonne * b / nbr_bandes);
+            bandes[b].derniere_colonne = (int)((long)nbr_colonne * (b+1) / nbr_bandes);
+            bandes[b].erreur = 0;
+            lance[b] = (pthread_create(&threads[b], NULL, filtre_bande_median, &bandes[b])==0);
+            if(!lance[b])
+                filtre_bande_median(&bandes[b]);
+        }
+        for(int b=0; b<nbr_bandes; b++){
+            if(lance[b])
+                pthread_join(threads[b], NULL);
+            if(bandes[b].erreur)
+                erreur = 1;
+        }
+    }
+
+    free(source);
+    if(erreur){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+    return 0;
+}
+
+static void *filtre_bande_median(void *arg){
+    Bande_median *bande = arg;
+    int nbr_ligne = acces_nbr_ligne_PNM(bande->image), nbr_colonne = acces_nbr_colonne_PNM(bande->image);
+    int nbr_canaux = acces_nbr_canaux_PNM(bande->image), rayon = bande->rayon, nbr_classes = bande->nbr_classes;
+    //histogrammes des colonnes [debut, fin[: la bande et ses marges de rayon colonnes
+    int debut = borne(bande->premiere_colonne - rayon, 0, nbr_colonne-1);
+    int fin = borne(bande->derniere_colonne + rayon, 1, nbr_colonne);
+    unsigned long rang_median = ((unsigned long)(2*rayon+1) * (2*rayon+1)) / 2;
+    unsigned short *colonnes, *ajout, *retrait, *ligne;
+    unsigned int *fenetre;
+    unsigned long cumul;
+    int v;
+
+    colonnes = calloc((size_t)(fin-debut) * nbr_classes, sizeof(unsigned short));
+    fenetre = malloc(nbr_classes * sizeof(unsigned int));
+    if(colonnes==NULL || fenetre==NULL){
+        free(colonnes);
+        free(fenetre);
+        bande->erreur = 1;
+        return NULL;
+    }
+
+    //histogrammes de colonne initiaux: lignes -rayon à rayon (bords répétés)
+    for(int k=-rayon; k<=rayon; k++){
+        const unsigned short *source = bande->source + (size_t)borne(k, 0, nbr_ligne-1) * nbr_colonne;
+        for(int c=debut; c<fin; c++)
+            colonnes[(size_t)(c-debut)*nbr_classes + source[c]]++;
+    }
+
+    for(int i=0; i<nbr_ligne; i++){
+        //histogramme de la fenêtre du premier pixel de la bande
+        memset(fenetre, 0, nbr_classes * sizeof(unsigned int));
+        for(int d=-rayon; d<=rayon; d++){
+            ajout = colonnes + (size_t)(borne(bande->premiere_colonne + d, 0, nbr_colonne-1) - debut) * nbr_classes;
+            for(v=0; v<nbr_classes; v++)
+                fenetre[v] += ajout[v];
+        }
+
+        ligne = acces_ligne_PNM(bande->image, i);
+        for(int j=bande->premiere_colonne; j<bande->derniere_colonne; j++){
+            if(j>bande->premiere_colonne){
+                //glissement d'une colonne: ajout de la colonne entrante, retrait de la sortante
+                ajout = colonnes + (size_t)(borne(j+rayon, 0, nbr_colonne-1) - debut) * nbr_classes;
+                retrait = colonnes + (size_t)(borne(j-rayon-1, 0, nbr_colonne-1) - debut) * nbr_classes;
+                for(v=0; v<nbr_classes; v++)
+                    fenetre[v] += ajout[v] - retrait[v];
+            }
+
+            cumul = 0;
+            for(v=0; v<nbr_classes-1; v++){
+                cumul += fenetre[v];
+                if(cumul > rang_median)
+                    break;
+            }
+            ligne[j*nbr_canaux + bande->canal] = v;
+        }
+
+        //glissement des histogrammes de colonne d'une ligne vers le bas
+        if(i+1<nbr_ligne){
+            const unsigned short *sortante = bande->source + (size_t)borne(i-rayon, 0, nbr_ligne-1) * nbr_colonne;
+            const unsigned short *entrante = bande->source + (size_t)borne(i+rayon+1, 0, nbr_ligne-1) * nbr_colonne;
+            for(int c=debut; c<fin; c++){
+                colonnes[(size_t)(c-debut)*nbr_classes + sortante[c]]--;
+                colonnes[(size_t)(c-debut)*nbr_classes + entrante[c]]++;
+            }
+        }
+    }
+
+    free(colonnes);
+    free(fenetre);
+    return NULL;
+}
+
+static inline int borne(int valeur, int min, int max){
+    return valeur<min ? min : (valeur>max ? max : valeur);
+}
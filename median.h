@@ -0,0 +1,41 @@
+/**
+ * \file median.h
+ * \brief Ce fichier contient le prototype du filtre médian en temps constant pour images PNM.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+//Include guard
+#ifndef __MEDIAN__
+#define __MEDIAN__
+
+#include "pnm.h"
+
+/**
+ * \fn median(PNM *image, int rayon)
+ * \brief Remplace chaque valeur par la médiane de la fenêtre de rayon donné
+ * 
+ * Algorithme de Perreault et Hébert: un histogramme par colonne, glissé d'une
+ * ligne à chaque étape, et un histogramme de fenêtre glissé d'une colonne en
+ * ajoutant et retirant deux histogrammes de colonne. Le coût par pixel ne
+ * dépend pas du rayon. L'image est découpée en bandes verticales traitées
+ * en parallèle; chaque composante d'une image PPM est filtrée séparément.
+ * Les bords sont prolongés par répétition.
+ * 
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param rayon le rayon de la fenêtre (côté 2*rayon+1)
+ * 
+ * \pre image!=NULL, 0<=rayon<=32767
+ * \post valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pgm ou ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ * 
+ */
+int median(PNM *image, int rayon);
+
+#endif
@@ -0,0 +1,271 @@
+/**
+ * \file morphologie.c
+ * \brief Ce fichier contient les fonctions de morphologie mathématique sur images PBM compactées en mots de 64 bits.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "morphologie.h"
+#include "pnm.h"
+
+/**
+ * Hauteur d'élément structurant à partir de laquelle la passe verticale
+ * utilise van Herk / Gil-Werman plutôt que des ET/OU directs
+ */
+#define SEUIL_VAN_HERK 4
+
+/**
+ * \struct Image_binaire
+ * \brief Image PBM compactée: le bit j%64 du mot j/64 d'une ligne est le pixel j
+ */
+typedef struct {
+    int nbr_ligne, nbr_colonne, nbr_mots;
+    uint64_t *mots;
+    uint64_t masque_dernier_mot;//bits du dernier mot qui appartiennent à l'image
+} Image_binaire;
+
+/**
+ * Déclaration des fonctions statiques
+ * 
+ */
+static int compacte(PNM *image, Image_binaire *binaire);
+static void decompacte(const Image_binaire *binaire, PNM *image);
+static int fenetre_binaire(Image_binaire *binaire, int avant_x, int apres_x, int avant_y, int apres_y, int et);
+static void fenetre_horizontale(uint64_t *ligne, uint64_t *tampon, uint64_t *puissance, int nbr_mots, uint64_t masque, int avant, int apres, int et);
+static void fenetre_demi(const uint64_t *ligne, uint64_t *resultat, uint64_t *puissance, int nbr_mots, int longueur, int sens, uint64_t neutre, int et);
+static void fenetre_verticale(Image_binaire *binaire, uint64_t *tampon, int avant, int apres, int et);
+static void decale_ligne(const uint64_t *source, uint64_t *destination, int nbr_mots, int decalage, uint64_t remplissage);
+
+
+int morphologie(PNM *image, Operation_morphologique operation, int largeur, int hauteur){
+    assert(image!=NULL && largeur>=1 && hauteur>=1);
+    Image_binaire binaire;
+    //élément structurant centré: [-ax, bx] x [-ay, by]
+    int ax = (largeur-1)/2, bx = largeur-1-ax, ay = (hauteur-1)/2, by = hauteur-1-ay;
+    int erreur = 0;
+
+    if(acces_format_PNM(image)!=1){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PBM pour y appliquer une opération morphologique.\n");
+        return -1;
+    }
+    if(compacte(image, &binaire)==-1){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+
+    /*érosion: ET sur les décalages [-a, b]; dilatation: OU sur l'élément réfléchi [-b, a],
+    ce qui rend l'ouverture et la fermeture idempotentes même pour un élément de taille paire*/
+    switch(operation){
+    case erosion:
+        erreur = fenetre_binaire(&binaire, ax, bx, ay, by, 1);
+        break;
+    case dilatation:
+        erreur = fenetre_binaire(&binaire, bx, ax, by, ay, 0);
+        break;
+    case ouverture:
+        erreur = fenetre_binaire(&binaire, ax, bx, ay, by, 1) || fenetre_binaire(&binaire, bx, ax, by, ay, 0);
+        break;
+    case fermeture:
+        erreur = fenetre_binaire(&binaire, bx, ax, by, ay, 0) || fenetre_binaire(&binaire, ax, bx, ay, by, 1);
+        break;
+    }
+
+    if(!erreur)
+        decompacte(&binaire, image);
+    free(binaire.mots);
+    if(erreur){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+    return 0;
+}
+
+static int compacte(PNM *image, Image_binaire *binaire){
+    int nbr_canaux = acces_nbr_canaux_PNM(image);
+    unsigned short *ligne;
+    uint64_t *mots;
+
+    binaire->nbr_ligne = acces_nbr_ligne_PNM(image);
+    binaire->nbr_colonne = acces_nbr_colonne_PNM(image);
+    binaire->nbr_mots = (binaire->nbr_colonne + 63) / 64;
+    binaire->masque_dernier_mot = (binaire->nbr_colonne % 64) ? (((uint64_t)1 << (binaire->nbr_colonne % 64)) - 1) : ~(uint64_t)0;
+    binaire->mots = calloc((size_t)binaire->nbr_ligne * binaire->nbr_mots, sizeof(uint64_t));
+    if(binaire->mots==NULL)
+        return -1;
+
+    for(int i=0; i<binaire->nbr_ligne; i++){
+        ligne = acces_ligne_PNM(image, i);
+        mots = binaire->mots + (size_t)i * binaire->nbr_mots;
+        for(int j=0; j<binaire->nbr_colonne; j++)
+            mots[j/64] |= (uint64_t)(ligne[j*nbr_canaux] & 1) << (j%64);
+    }
+
+    return 0;
+}
+
+static void decompacte(const Image_binaire *binaire, PNM *image){
+    int nbr_canaux = acces_nbr_canaux_PNM(image);
+    unsigned short *ligne;
+    const uint64_t *mots;
+
+    for(int i=0; i<binaire->nbr_ligne; i++){
+        ligne = acces_ligne_PNM(image, i);
+        mots = binaire->mots + (size_t)i * binaire->nbr_mots;
+        for(int j=0; j<binaire->nbr_colonne; j++)
+            ligne[j*nbr_canaux] = (mots[j/64] >> (j%64)) & 1;
+    }
+}
+
+static int fenetre_binaire(Image_binaire *binaire, int avant_x, int apres_x, int avant_y, int apres_y, int et){
+    //van Herk / Gil-Werman: préfixes et suffixes d'au plus nbr_ligne + 3*hauteur lignes étendues
+    size_t taille_tampon = (size_t)(binaire->nbr_ligne + 3*(avant_y+apres_y+1)) * binaire->nbr_mots * 2;
+    uint64_t *tampon = malloc((taille_tampon > (size_t)4*binaire->nbr_mots ? taille_tampon : (size_t)4*binaire->nbr_mots) * sizeof(uint64_t));
+    if(tampon==NULL)
+        return -1;
+
+    //passe horizontale, ligne par ligne
+    if(avant_x+apres_x>0){
+        for(int i=0; i<binaire->nbr_ligne; i++)
+            fenetre_horizontale(binaire->mots + (size_t)i*binaire->nbr_mots, tampon, tampon + binaire->nbr_mots,
+                                binaire->nbr_mots, binaire->masque_dernier_mot, avant_x, apres_x, et);
+    }
+    //passe verticale, 64 colonnes à la fois
+    if(avant_y+apres_y>0)
+        fenetre_verticale(binaire, tampon, avant_y, apres_y, et);
+
+    free(tampon);
+    return 0;
+}
+
+static void fenetre_horizontale(uint64_t *ligne, uint64_t *tampon, uint64_t *puissance, int nbr_mots, uint64_t masque, int avant, int apres, int et){
+    uint64_t neutre = et ? ~(uint64_t)0 : 0;
+    uint64_t *resultat = puissance + 2*nbr_mots;
+
+    //les bits hors de l'image sont neutres
+    ligne[nbr_mots-1] = et ? (ligne[nbr_mots-1] | ~masque) : (ligne[nbr_mots-1] & masque);
+
+    /*les décalages ne font entrer que des bits neutres du côté vers lequel ils lisent:
+    la fenêtre [j-avant, j+apres] est l'op de [j, j+apres] et de [j-avant, j]*/
+    fenetre_demi(ligne, resultat, puissance, nbr_mots, apres+1, 1, neutre, et);
+    if(avant>0){
+        fenetre_demi(ligne, tampon, puissance, nbr_mots, avant+1, -1, neutre, et);
+        for(int m=0; m<nbr_mots; m++)
+            resultat[m] = et ? (resultat[m] & tampon[m]) : (resultat[m] | tampon[m]);
+    }
+    memcpy(ligne, resultat, nbr_mots * sizeof(uint64_t));
+    ligne[nbr_mots-1] &= masque;
+}
+
+static void fenetre_demi(const uint64_t *ligne, uint64_t *resultat, uint64_t *puissance, int nbr_mots, int longueur, int sens, uint64_t neutre, int et){
+    uint64_t *decale = puissance + nbr_mots;
+    int couvert = 0;
+
+    /*puissance(j) couvre les 2^k pixels à partir de j dans le sens donné; le résultat
+    est combiné à partir des puissances de 2 de la décomposition binaire de longueur*/
+    memcpy(puissance, ligne, nbr_mots * sizeof(uint64_t));
+    for(int k=0; (1<<k) <= longueur; k++){
+        if(longueur & (1<<k)){
+            if(couvert==0)
+                memcpy(resultat, puissance, nbr_mots * sizeof(uint64_t));
+            else{
+                decale_ligne(puissance, decale, nbr_mots, sens*couvert, neutre);
+                for(int m=0; m<nbr_mots; m++)
+                    resultat[m] = et ? (resultat[m] & decale[m]) : (resultat[m] | decale[m]);
+            }
+            couvert += 1<<k;
+        }
+        if((2<<k) <= longueur){
+            decale_ligne(puissance, decale, nbr_mots, sens*(1<<k), neutre);
+            for(int m=0; m<nbr_mots; m++)
+                puissance[m] = et ? (puissance[m] & decale[m]) : (puissance[m] | decale[m]);
+        }
+    }
+}
+
+static void fenetre_verticale(Image_binaire *binaire, uint64_t *tampon, int avant, int apres, int et){
+    int nbr_mots = binaire->nbr_mots, hauteur = avant + apres + 1, i, m;
+    uint64_t neutre = et ? ~(uint64_t)0 : 0, *ligne, *source;
+
+    if(hauteur < SEUIL_VAN_HERK){
+        //petit élément: op direct des lignes voisines, sur une copie des lignes originales
+        uint64_t *copie = tampon;
+        memcpy(copie, binaire->mots, (size_t)binaire->nbr_ligne * nbr_mots * sizeof(uint64_t));
+        for(i=0; i<binaire->nbr_ligne; i++){
+            ligne = binaire->mots + (size_t)i*nbr_mots;
+            for(m=0; m<nbr_mots; m++)
+                ligne[m] = neutre;
+            for(int d=-avant; d<=apres; d++){
+                if(i+d<0 || i+d>=binaire->nbr_ligne)
+                    continue;
+                source = copie + (size_t)(i+d)*nbr_mots;
+                for(m=0; m<nbr_mots; m++)
+                    ligne[m] = et ? (ligne[m] & source[m]) : (ligne[m] | source[m]);
+            }
+        }
+        return;
+    }
+
+    /*van Herk / Gil-Werman: les lignes, précédées de avant lignes neutres et complétées par des lignes
+    neutres, sont découpées en blocs de hauteur lignes. prefixe[r] = op des lignes du début du bloc de r à r,
+    suffixe[r] = op des lignes de r à la fin de son bloc; la fenêtre [s, s+hauteur[ vaut suffixe[s] op prefixe[s+hauteur-1]*/
+    int nbr_etendues = ((avant + binaire->nbr_ligne + apres + hauteur - 1) / hauteur + 1) * hauteur;
+    uint64_t *prefixe = tampon, *suffixe = tampon + (size_t)nbr_etendues * nbr_mots;
+    uint64_t *p, *s, valeur;
+
+    for(int r=0; r<nbr_etendues; r++){
+        p = prefixe + (size_t)r*nbr_mots;
+        for(m=0; m<nbr_mots; m++){
+            i = r - avant;
+            valeur = (i>=0 && i<binaire->nbr_ligne) ? binaire->mots[(size_t)i*nbr_mots + m] : neutre;
+            if(r % hauteur != 0)
+                valeur = et ? (valeur & p[m - nbr_mots]) : (valeur | p[m - nbr_mots]);
+            p[m] = valeur;
+        }
+    }
+    for(int r=nbr_etendues-1; r>=0; r--){
+        s = suffixe + (size_t)r*nbr_mots;
+        for(m=0; m<nbr_mots; m++){
+            i = r - avant;
+            valeur = (i>=0 && i<binaire->nbr_ligne) ? binaire->mots[(size_t)i*nbr_mots + m] : neutre;
+            if(r % hauteur != hauteur-1)
+                valeur = et ? (valeur & s[m + nbr_mots]) : (valeur | s[m + nbr_mots]);
+            s[m] = valeur;
+        }
+    }
+
+    //la ligne i correspond à la fenêtre des lignes étendues [i, i+hauteur[
+    for(i=0; i<binaire->nbr_ligne; i++){
+        ligne = binaire->mots + (size_t)i*nbr_mots;
+        s = suffixe + (size_t)i*nbr_mots;
+        p = prefixe + (size_t)(i+hauteur-1)*nbr_mots;
+        for(m=0; m<nbr_mots; m++)
+            ligne[m] = et ? (s[m] & p[m]) : (s[m] | p[m]);
+    }
+}
+
+static void decale_ligne(const uint64_t *source, uint64_t *destination, int nbr_mots, int decalage, uint64_t remplissage){
+    //destination bit j = source bit j+decalage, remplissage hors de la ligne
+    int mots = decalage>=0 ? decalage/64 : -((-decalage)/64), bits = decalage>=0 ? decalage%64 : (-decalage)%64;
+    uint64_t bas, haut;
+
+    for(int m=0; m<nbr_mots; m++){
+        if(decalage>=0){
+            bas = (m+mots < nbr_mots) ? source[m+mots] : remplissage;
+            haut = (m+mots+1 < nbr_mots) ? source[m+mots+1] : remplissage;
+            destination[m] = bits ? ((bas >> bits) | (haut << (64-bits))) : bas;
+        }
+        else{
+            haut = (m+mots >= 0) ? source[m+mots] : remplissage;
+            bas = (m+mots-1 >= 0) ? source[m+mots-1] : remplissage;
+            destination[m] = bits ? ((haut << bits) | (bas >> (64-bits))) : haut;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * \file morphologie.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes des fonctions de morphologie mathématique sur images PBM.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+//Include guard
+#ifndef __MORPHOLOGIE__
+#define __MORPHOLOGIE__
+
+#include "pnm.h"
+
+/**
+ * \enum typedef enum Operation_morphologique
+ * \brief Opération de morphologie mathématique
+ * 
+ */
+typedef enum
+{
+    erosion,
+    dilatation,
+    ouverture,//érosion puis dilatation
+    fermeture//dilatation puis érosion
+} Operation_morphologique;
+
+/**
+ * \fn morphologie(PNM *image, Operation_morphologique operation, int largeur, int hauteur)
+ * \brief Applique une opération morphologique à une image PBM avec un 
+ * élément structurant rectangulaire
+ * 
+ * Les pixels valant 1 forment l'objet. L'image est compactée à raison de
+ * 64 pixels par mot de 64 bits. Le rectangle est décomposé en un segment
+ * horizontal, traité par décalages et ET/OU en O(log largeur) opérations par
+ * mot, et un segment vertical, traité par l'algorithme de van Herk /
+ * Gil-Werman en 3 opérations par mot quelle que soit la hauteur. Les pixels
+ * hors de l'image sont neutres (1 pour l'érosion, 0 pour la dilatation).
+ * 
+ * \param image pointeur sur PNM au format PBM
+ * \param operation l'opération à appliquer
+ * \param largeur, hauteur les dimensions de l'élément structurant, centré
+ * 
+ * \pre image!=NULL, largeur>=1, hauteur>=1
+ * \post valeurs du tableau de pixel modifiées
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de pbm \n
+ *      -2 Erreur d'allocation de mémoire
+ * 
+ */
+int morphologie(PNM *image, Operation_morphologique operation, int largeur, int hauteur);
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * \file ordonnanceur.c
+ * \brief Ce fichier contient l'ordonnanceur de tuiles à vol de travail.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "ordonnanceur.h"
+#include "trace.h"
+#include "pnm.h"
+
+/**
+ * Taille visée (en octets de valeurs) d'une tuile et sa hauteur en lignes
+ */
+#define TAILLE_TUILE_CIBLE (32 << 10)
+#define HAUTEUR_TUILE 16
+
+/**
+ * Nombre de pixels en dessous duquel les tuiles sont traitées sans thread
+ */
+#define SEUIL_TUILES_PARALLELE (1 << 15)
+
+/**
+ * \struct File_tuiles
+ * \brief Tuiles [debut, fin[ restant à traiter par un thread
+ *
+ * Le propriétaire prend les tuiles par le début, un voleur prend la moitié
+ * de fin. Le remplissage place chaque file sur sa propre ligne de cache.
+ */
+typedef struct {
+    pthread_mutex_t verrou;
+    int debut, fin;
+    char remplissage[64];
+} File_tuiles;
+
+/**
+ * \struct Ordonnanceur
+ * \brief Files de tous les threads et tâche à appliquer à chaque indice
+ */
+typedef struct {
+    File_tuiles files[NBR_MAX_THREADS];
+    int nbr_files;
+    Traitement_tache tache;
+    void *contexte;
+} Ordonnanceur;
+
+/**
+ * \struct Decoupage
+ * \brief Découpage d'une image en tuiles: la tâche d'indice t traite la tuile t
+ */
+typedef struct {
+    int nbr_ligne, nbr_colonne, largeur_tuile, hauteur_tuile, nbr_tuiles_ligne;
+    Traitement_tuile traitement;
+    void *contexte;
+} Decoupage;
+
+/**
+ * \struct Travailleur
+ * \brief Thread de l'ordonnanceur: sa file et l'état de son choix de victime
+ */
+typedef struct {
+    Ordonnanceur *ordonnanceur;
+    int numero;
+    unsigned int alea;
+} Travailleur;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void *travaille(void *arg);
+static int prend_tuile(File_tuiles *file);
+static int vole_tuiles(Travailleur *travailleur);
+static void traite_tuile(int indice, void *contexte);
+
+
+void execute_tuiles(int nbr_ligne, int nbr_colonne, int octets_par_pixel, Traitement_tuile traitement, void *contexte){
+    assert(nbr_ligne>=0 && nbr_colonne>=0 && octets_par_pixel>=1 && traitement!=NULL);
+    Decoupage decoupage;
+    int nbr_tuiles;
+
+    if(nbr_ligne==0 || nbr_colonne==0)
+        return;
+
+    //tuiles de HAUTEUR_TUILE lignes, aussi larges que le permet TAILLE_TUILE_CIBLE (multiple de 16 colonnes)
+    decoupage.nbr_ligne = nbr_ligne;
+    decoupage.nbr_colonne = nbr_colonne;
+    decoupage.hauteur_tuile = (nbr_ligne < HAUTEUR_TUILE) ? nbr_ligne : HAUTEUR_TUILE;
+    decoupage.largeur_tuile = (TAILLE_TUILE_CIBLE / (HAUTEUR_TUILE * octets_par_pixel)) & ~15;
+    if(decoupage.largeur_tuile < 16)
+        decoupage.largeur_tuile = 16;
+    if(decoupage.largeur_tuile > nbr_colonne)
+        decoupage.largeur_tuile = nbr_colonne;
+    decoupage.nbr_tuiles_ligne = (nbr_colonne + decoupage.largeur_tuile - 1) / decoupage.largeur_tuile;
+    nbr_tuiles = decoupage.nbr_tuiles_ligne * ((nbr_ligne + decoupage.hauteur_tuile - 1) / decoupage.hauteur_tuile);
+    decoupage.traitement = traitement;
+    decoupage.contexte = contexte;
+
+    if((long)nbr_ligne * nbr_colonne < SEUIL_TUILES_PARALLELE){
+        for(int t=0; t<nbr_tuiles; t++)
+            traite_tuile(t, &decoupage);
+        return;
+    }
+    execute_taches(nbr_tuiles, traite_tuile, &decoupage);
+}
+
+void execute_taches(int nbr_taches, Traitement_tache tache, void *contexte){
+    assert(nbr_taches>=0 && tache!=NULL);
+    Ordonnanceur ordonnanceur;
+    Travailleur travailleurs[NBR_MAX_THREADS];
+    pthread_t threads[NBR_MAX_THREADS];
+    int lance[NBR_MAX_THREADS];
+    int nbr_threads, initialisees;
+
+    ordonnanceur.tache = tache;
+    ordonnanceur.contexte = contexte;
+
+    nbr_threads = nombre_threads_disponibles();
+    if(nbr_threads > nbr_taches)
+        nbr_threads = nbr_taches;
+    if(nbr_threads<=1){
+        for(int t=0; t<nbr_taches; t++)
+            tache(t, contexte);
+        return;
+    }
+
+    //chaque file reçoit une suite de tâches voisines (tuiles voisines, dans l'ordre des lignes)
+    for(initialisees=0; initialisees<nbr_threads; initialisees++){
+        if(pthread_mutex_init(&ordonnanceur.files[initialisees].verrou, NULL)!=0)
+            break;
+        ordonnanceur.files[initialisees].debut = (int)((long)nbr_taches * initialisees / nbr_threads);
+        ordonnanceur.files[initialisees].fin = (int)((long)nbr_taches * (initialisees+1) / nbr_threads);
+    }
+    if(initialisees<nbr_threads){
+        for(int k=0; k<initialisees; k++)
+            pthread_mutex_destroy(&ordonnanceur.files[k].verrou);
+        for(int t=0; t<nbr_taches; t++)
+            tache(t, contexte);
+        return;
+    }
+    ordonnanceur.nbr_files = nbr_threads;
+
+    //le thread appelant est le travailleur 0; la file d'un thread non lancé est volée par les autres
+    for(int k=0; k<nbr_threads; k++){
+        travailleurs[k].ordonnanceur = &ordonnanceur;
+        travailleurs[k].numero = k;
+        travailleurs[k].alea = 2654435761u * (k+1);
+        lance[k] = (k>0 && pthread_create(&threads[k], NULL, travaille, &travailleurs[k])==0);
+    }
+    travaille(&travailleurs[0]);
+    for(int k=1; k<nbr_threads; k++){
+        if(lance[k])
+            pthread_join(threads[k], NULL);
+    }
+
+    for(int k=0; k<nbr_threads; k++)
+        pthread_mutex_destroy(&ordonnanceur.files[k].verrou);
+}
+
+static void *travaille(void *arg){
+    Travailleur *travailleur = arg;
+    Ordonnanceur *ordonnanceur = travailleur->ordonnanceur;
+    int indice;
+    unsigned long long trace;
+
+    //aucune tuile n'est ajoutée en cours de route: toutes les files vides signifient la fin du travail
+    for(;;){
+        indice = prend_tuile(&ordonnanceur->files[travailleur->numero]);
+        if(indice<0){
+            if(vole_tuiles(travailleur)!=0)
+                break;
+            continue;
+        }
+        trace = debut_trace();
+        ordonnanceur->tache(indice, ordonnanceur->contexte);
+        fin_trace("tache", trace);
+    }
+
+    return NULL;
+}
+
+static int prend_tuile(File_tuiles *file){
+    int indice = -1;
+
+    pthread_mutex_lock(&file->verrou);
+    if(file->debut < file->fin)
+        indice = file->debut++;
+    pthread_mutex_unlock(&file->verrou);
+
+    return indice;
+}
+
+static int vole_tuiles(Travailleur *travailleur){
+    Ordonnanceur *ordonnanceur = travailleur->ordonnanceur;
+    File_tuiles *victime, *propre = &ordonnanceur->files[travailleur->numero];
+    int nbr_files = ordonnanceur->nbr_files, premiere, nbr_volees, debut_vol = 0;
+
+    //victimes parcourues à partir d'une file tirée au hasard (xorshift)
+    travailleur->alea ^= travailleur->alea << 13;
+    travailleur->alea ^= travailleur->alea >> 17;
+    travailleur->alea ^= travailleur->alea << 5;
+    premiere = travailleur->alea % nbr_files;
+
+    for(int k=0; k<nbr_files; k++){
+        victime = &ordonnanceur->files[(premiere + k) % nbr_files];
+        if(victime==propre)
+            continue;
+
+        pthread_mutex_lock(&victime->verrou);
+        nbr_volees = (victime->fin - victime->debut + 1) / 2;
+        if(nbr_volees>0){
+            victime->fin -= nbr_volees;
+            debut_vol = victime->fin;
+        }
+        pthread_mutex_unlock(&victime->verrou);
+
+        if(nbr_volees>0){
+            pthread_mutex_lock(&propre->verrou);
+            propre->debut = debut_vol;
+            propre->fin = debut_vol + nbr_volees;
+            pthread_mutex_unlock(&propre->verrou);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static void traite_tuile(int indice, void *contexte){
+    Decoupage *decoupage = contexte;
+    Tuile tuile;
+
+    tuile.x = (indice % decoupage->nbr_tuiles_ligne) * decoupage->largeur_tuile;
+    tuile.y = (indice / decoupage->nbr_tuiles_ligne) * decoupage->hauteur_tuile;
+    tuile.largeur = decoupage->nbr_colonne - tuile.x;
+    if(tuile.largeur > decoupage->largeur_tuile)
+        tuile.largeur = decoupage->largeur_tuile;
+    tuile.hauteur = decoupage->nbr_ligne - tuile.y;
+    if(tuile.hauteur > decoupage->hauteur_tuile)
+        tuile.hauteur = decoupage->hauteur_tuile;
+
+    decoupage->traitement(&tuile, decoupage->contexte);
+}
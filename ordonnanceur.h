@@ -0,0 +1,75 @@
+/**
+ * \file ordonnanceur.h
+ * \brief Ce fichier contient les déclarations de l'ordonnanceur de tuiles à vol de travail.
+ *
+ * L'image est découpée en tuiles dont les valeurs tiennent dans le cache de
+ * données d'un coeur. Chaque thread reçoit une file de tuiles voisines, qu'il
+ * traite dans l'ordre; un thread dont la file est vide vole la moitié des
+ * tuiles restantes de la file d'un autre thread. Les coeurs restent occupés
+ * même si le coût des tuiles varie (région d'intérêt, bords, contenu).
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __ORDONNANCEUR__
+#define __ORDONNANCEUR__
+
+/**
+ * \struct Tuile
+ * \brief Rectangle [x, x+largeur[ x [y, y+hauteur[ de l'image
+ */
+typedef struct {
+    int x, y, largeur, hauteur;
+} Tuile;
+
+/**
+ * Traitement d'une tuile; contexte est partagé par tous les threads
+ */
+typedef void (*Traitement_tuile)(const Tuile *tuile, void *contexte);
+
+/**
+ * Traitement de la tâche d'indice donné; contexte est partagé par tous les threads
+ */
+typedef void (*Traitement_tache)(int indice, void *contexte);
+
+/**
+ * \fn execute_tuiles(int nbr_ligne, int nbr_colonne, int octets_par_pixel, Traitement_tuile traitement, void *contexte)
+ * \brief Applique traitement à toutes les tuiles d'une image de dimensions données
+ *
+ * Les tuiles sont traitées en parallèle et dans un ordre quelconque:
+ * traitement ne doit écrire que dans sa tuile. Sans thread disponible, les
+ * tuiles sont traitées par le thread appelant.
+ *
+ * \param nbr_ligne la hauteur de l'image
+ * \param nbr_colonne la largeur de l'image
+ * \param octets_par_pixel les octets lus et écrits par pixel, pour la taille des tuiles
+ * \param traitement la fonction appliquée à chaque tuile
+ * \param contexte pointeur transmis à traitement
+ *
+ * \pre nbr_ligne>=0, nbr_colonne>=0, octets_par_pixel>=1, traitement!=NULL
+ * \post traitement a été appliqué une fois à chaque tuile
+ *
+ */
+void execute_tuiles(int nbr_ligne, int nbr_colonne, int octets_par_pixel, Traitement_tuile traitement, void *contexte);
+
+/**
+ * \fn execute_taches(int nbr_taches, Traitement_tache tache, void *contexte)
+ * \brief Applique tache aux indices 0 à nbr_taches-1, avec le même vol de travail que les tuiles
+ *
+ * Les tâches sont traitées en parallèle et dans un ordre quelconque; des
+ * tâches d'indices voisins sont de préférence traitées par le même thread.
+ *
+ * \param nbr_taches le nombre de tâches
+ * \param tache la fonction appliquée à chaque indice
+ * \param contexte pointeur transmis à tache
+ *
+ * \pre nbr_taches>=0, tache!=NULL
+ * \post tache a été appliquée une fois à chaque indice
+ *
+ */
+void execute_taches(int nbr_taches, Traitement_tache tache, void *contexte);
+
+#endif
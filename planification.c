@@ -0,0 +1,355 @@
+/**
+ * \file planification.c
+ * \brief Ce fichier contient le planificateur d'exécution sous budget mémoire et le traitement par bandes.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include "planification.h"
+#include "registre.h"
+#include "pnm.h"
+#include "compression.h"
+
+/**
+ * Les bandes commencent sur un multiple de cette hauteur, ce qui conserve
+ * l'alignement de la matrice de Bayer 8x8 du tramage ordonné
+ */
+#define ALIGNEMENT_BANDE 8
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static unsigned long long memoire_lignes(const Entete_PNM *entete, const Filtre_prepare *filtre, int nbr_ligne);
+static unsigned long long memoire_bandes(const Entete_PNM *entete, const Filtre_prepare *filtre, int lignes_par_bande, int halo, Mode_execution mode);
+static FILE *ouvre_sortie(PNM *bande, int nbr_ligne, char *filename_output);
+static int execute_bandes_inversees(const Plan_execution *plan, const Filtre_prepare *filtre, char *filename, char *filename_output);
+static int signale_resultat(int resultat);
+
+
+int planifie_execution(Plan_execution *plan, const Entete_PNM *entete, const Filtre_prepare *filtre, int bandes_possibles, unsigned long long budget){
+    assert(plan!=NULL && entete!=NULL);
+    int halo = 0, min, max, milieu, nbr_alignements = (entete->nbr_ligne + ALIGNEMENT_BANDE - 1) / ALIGNEMENT_BANDE;
+    Mode_execution mode;
+
+    //en mémoire: image entière et, pour l'analyse parallèle, tout le contenu du fichier
+    plan->mode = execution_memoire;
+    plan->lignes_par_bande = entete->nbr_ligne;
+    plan->halo = 0;
+    plan->memoire_estimee = memoire_lignes(entete, filtre, entete->nbr_ligne);
+    if(entete->taille_fichier > entete->position_valeurs)
+        plan->memoire_estimee += entete->taille_fichier - entete->position_valeurs;
+    if(budget==0 || plan->memoire_estimee <= budget)
+        return 0;
+
+    if(filtre!=NULL && filtre->descripteur->halo!=NULL)
+        halo = filtre->descripteur->halo(&filtre->parametre);
+    if(!bandes_possibles)
+        return -2;
+    mode = (halo==0) ? execution_flux_lignes : execution_tuiles;
+
+    //filtre global dont chaque ligne ne dépend que de sa symétrique: bandes lues de la dernière à la première
+    if(halo<0){
+        if(!filtre->descripteur->lignes_inversees || entete->taille_fichier <= entete->position_valeurs)
+            return -2;
+        halo = 0;
+        mode = execution_bandes_inversees;
+    }
+    if(memoire_bandes(entete, filtre, ALIGNEMENT_BANDE, halo, mode) > budget)
+        return -1;
+
+    //plus grand nombre d'alignements par bande dont l'estimation respecte le budget (croissante)
+    min = 1;
+    max = nbr_alignements;
+    while(min<max){
+        milieu = (min + max + 1) / 2;
+        if(memoire_bandes(entete, filtre, milieu * ALIGNEMENT_BANDE, halo, mode) <= budget)
+            min = milieu;
+        else
+            max = milieu - 1;
+    }
+
+    plan->mode = mode;
+    plan->lignes_par_bande = min * ALIGNEMENT_BANDE;
+    plan->halo = halo;
+    plan->memoire_estimee = memoire_bandes(entete, filtre, plan->lignes_par_bande, halo, mode);
+    return 0;
+}
+
+int execute_plan_bandes(const Plan_execution *plan, const Filtre_prepare *filtre, char *filename, char *filename_output){
+    assert(plan!=NULL && filtre!=NULL && filename!=NULL && filename_output!=NULL);
+    Entete_PNM entete;
+    FILE *fichier, *sortie = NULL;
+    PNM *tampon, *lecture, *bande, *coeur;
+    unsigned short *sauvegarde;
+    int erreur, nbr_ligne, nbr_colonne, nbr_canaux, hauteur_tampon, halo = plan->halo, resultat = 0;
+    int debut, fin, premiere, derniere, prochaine, lues = 0;
+    size_t taille_ligne;
+
+    if(plan->mode==execution_bandes_inversees)
+        return execute_bandes_inversees(plan, filtre, filename, filename_output);
+
+    fichier = ouvre_fichier_PNM(filename, &entete, &erreur);
+    if(fichier==NULL)
+        return -1;
+    nbr_ligne = entete.nbr_ligne;
+    nbr_colonne = entete.nbr_colonne;
+
+    //une bande et son halo, et les lignes du halo conservées pour la bande suivante
+    hauteur_tampon = plan->lignes_par_bande + 2*halo;
+    if(hauteur_tampon > nbr_ligne)
+        hauteur_tampon = nbr_ligne;
+    tampon = constructeur_PNM(hauteur_tampon, nbr_colonne, entete.format, entete.valeur_max);
+    nbr_canaux = (entete.format==3) ? 3 : 1;
+    taille_ligne = (size_t)nbr_colonne * nbr_canaux * sizeof(unsigned short);
+    sauvegarde = malloc((halo>0 ? 2*halo : 1) * taille_ligne);
+    if(tampon==NULL || sauvegarde==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        if(tampon!=NULL)
+            libere_PNM(&tampon);
+        free(sauvegarde);
+        ferme_fichier_image(fichier);
+        return -2;
+    }
+
+    for(debut=0; debut<nbr_ligne && resultat==0; debut=fin){
+        fin = (debut + plan->lignes_par_bande < nbr_ligne) ? debut + plan->lignes_par_bande : nbr_ligne;
+        premiere = (debut - halo > 0) ? debut - halo : 0;
+        derniere = (fin + halo < nbr_ligne) ? fin + halo : nbr_ligne;
+
+        //lignes [premiere, lues[ conservées avant filtrage, puis lecture des lignes [lues, derniere[
+        for(int k=0; k<lues-premiere; k++)
+            memcpy(acces_ligne_PNM(tampon, k), sauvegarde + (size_t)k * nbr_colonne * nbr_canaux, taille_ligne);
+        if(derniere>lues){
+            lecture = vue_PNM(tampon, 0, lues-premiere, nbr_colonne, derniere-lues);
+            if(lecture==NULL){
+                resultat = -2;
+                break;
+            }
+            if(charge_lignes_fichier(lecture, fichier)!=0)
+                resultat = -1;
+            libere_PNM(&lecture);
+            if(resultat!=0)
+                break;
+            lues = derniere;
+        }
+
+        //les lignes [prochaine, derniere[ appartiennent aussi au halo de la bande suivante
+        prochaine = (fin - halo > 0) ? fin - halo : 0;
+        if(fin<nbr_ligne){
+            for(int k=prochaine; k<derniere; k++)
+                memcpy(sauvegarde + (size_t)(k-prochaine) * nbr_colonne * nbr_canaux, acces_ligne_PNM(tampon, k-premiere), taille_ligne);
+        }
+
+        bande = vue_PNM(tampon, 0, 0, nbr_colonne, derniere-premiere);
+        if(bande==NULL){
+            resultat = -2;
+            break;
+        }
+        if(applique_filtre(filtre, bande)!=0)
+            resultat = -3;
+
+        //l'en tête est écrit une fois le format du résultat connu
+        if(resultat==0 && sortie==NULL && (sortie = ouvre_sortie(bande, nbr_ligne, filename_output))==NULL)
+            resultat = -4;
+        if(resultat==0){
+            coeur = vue_PNM(bande, 0, debut-premiere, nbr_colonne, fin-debut);
+            if(coeur==NULL)
+                resultat = -2;
+            else{
+                if(ecrit_image_dans_fichier(coeur, sortie)!=0)
+                    resultat = -4;
+                libere_PNM(&coeur);
+            }
+        }
+        libere_PNM(&bande);
+    }
+
+    if(sortie!=NULL && ferme_fichier_image(sortie)!=0 && resultat==0)
+        resultat = -4;
+    ferme_fichier_image(fichier);
+    libere_PNM(&tampon);
+    free(sauvegarde);
+
+    return signale_resultat(resultat);
+}
+
+static int execute_bandes_inversees(const Plan_execution *plan, const Filtre_prepare *filtre, char *filename, char *filename_output){
+    Entete_PNM entete;
+    FILE *fichier, *sortie = NULL;
+    PNM *tampon, *bande;
+    long *positions;
+    int erreur, nbr_ligne, nbr_colonne, nbr_bandes, hauteur_tampon, debut, fin, resultat = 0;
+
+    fichier = ouvre_fichier_PNM(filename, &entete, &erreur);
+    if(fichier==NULL)
+        return -1;
+    nbr_ligne = entete.nbr_ligne;
+    nbr_colonne = entete.nbr_colonne;
+    nbr_bandes = (nbr_ligne + plan->lignes_par_bande - 1) / plan->lignes_par_bande;
+    //le fichier est positionné juste avant la première valeur
+    entete.position_valeurs = ftell(fichier);
+
+    //une seule bande en mémoire, et la position de chaque bande dans le fichier
+    hauteur_tampon = (plan->lignes_par_bande < nbr_ligne) ? plan->lignes_par_bande : nbr_ligne;
+    tampon = constructeur_PNM(hauteur_tampon, nbr_colonne, entete.format, entete.valeur_max);
+    positions = malloc((nbr_bandes>0 ? nbr_bandes : 1) * sizeof(long));
+    if(tampon==NULL || positions==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        if(tampon!=NULL)
+            libere_PNM(&tampon);
+        free(positions);
+        ferme_fichier_image(fichier);
+        return -2;
+    }
+    if(indexe_lignes_PNM(filename, &entete, plan->lignes_par_bande, positions)!=0)
+        resultat = -1;
+
+    //la dernière bande du fichier, une fois filtrée, est la première du résultat
+    for(int b=nbr_bandes-1; b>=0 && resultat==0; b--){
+        debut = b * plan->lignes_par_bande;
+        fin = (debut + plan->lignes_par_bande < nbr_ligne) ? debut + plan->lignes_par_bande : nbr_ligne;
+        bande = vue_PNM(tampon, 0, 0, nbr_colonne, fin-debut);
+        if(bande==NULL){
+            resultat = -2;
+            break;
+        }
+        if(fseek(fichier, positions[b], SEEK_SET)!=0 || charge_lignes_fichier(bande, fichier)!=0)
+            resultat = -1;
+        else if(applique_filtre(filtre, bande)!=0)
+            resultat = -3;
+
+        if(resultat==0 && sortie==NULL && (sortie = ouvre_sortie(bande, nbr_ligne, filename_output))==NULL)
+            resultat = -4;
+        if(resultat==0 && ecrit_image_dans_fichier(bande, sortie)!=0)
+            resultat = -4;
+        libere_PNM(&bande);
+    }
+
+    if(sortie!=NULL && ferme_fichier_image(sortie)!=0 && resultat==0)
+        resultat = -4;
+    ferme_fichier_image(fichier);
+    libere_PNM(&tampon);
+    free(positions);
+
+    return signale_resultat(resultat);
+}
+
+static int signale_resultat(int resultat){
+    switch(resultat){
+    case -1:
+        printf("Erreur lors du chargement de l'image.\n");
+        break;
+    case -2:
+        printf("Allocation de mémoire impossible.\n");
+        break;
+    case -4:
+        printf("Un problème est survenu lors de l'écriture de l'image.\n");
+        break;
+    default:
+        break;
+    }
+    return resultat;
+}
+
+int lit_taille_memoire(const char *texte, unsigned long long *taille){
+    assert(texte!=NULL && taille!=NULL);
+    char *fin;
+    int decalage = 0;
+
+    errno = 0;
+    *taille = strtoull(texte, &fin, 10);
+    if(fin==texte || errno!=0 || *taille==0 || texte[0]=='-')
+        return -1;
+    switch(*fin){
+    case '\0':
+        break;
+    case 'k':
+    case 'K':
+        decalage = 10;
+        break;
+    case 'm':
+    case 'M':
+        decalage = 20;
+        break;
+    case 'g':
+    case 'G':
+        decalage = 30;
+        break;
+    default:
+        return -1;
+    }
+    if(decalage>0 && (fin[1]!='\0' || *taille > (~0ULL >> decalage)))
+        return -1;
+    *taille <<= decalage;
+
+    return 0;
+}
+
+void affiche_plan(const Plan_execution *plan, unsigned long long budget){
+    assert(plan!=NULL);
+    const char *modes[4] = {"en mémoire", "flux de lignes", "tuiles", "bandes inversées"};
+
+    printf("plan: %s, %d lignes par bande, halo de %d lignes, mémoire estimée %.1f Mo",
+           modes[plan->mode], plan->lignes_par_bande, plan->halo, plan->memoire_estimee / 1048576.0);
+    if(budget>0)
+        printf(" (budget %.1f Mo)\n", budget / 1048576.0);
+    else
+        printf(" (budget illimité)\n");
+}
+
+static unsigned long long memoire_lignes(const Entete_PNM *entete, const Filtre_prepare *filtre, int nbr_ligne){
+    unsigned long long nbr_canaux = (entete->format==3) ? 3 : 1;
+    unsigned long long nbr_pixels = (unsigned long long)nbr_ligne * entete->nbr_colonne;
+    unsigned long long memoire;
+
+    //valeurs, texte mis en forme pour l'écriture (au plus 6 octets par valeur)
+    memoire = nbr_pixels * nbr_canaux * sizeof(unsigned short) + nbr_pixels * nbr_canaux * 6 + nbr_ligne;
+    if(filtre!=NULL && filtre->descripteur->memoire_travail!=NULL)
+        memoire += filtre->descripteur->memoire_travail(&filtre->parametre, entete, nbr_ligne);
+    return memoire;
+}
+
+static unsigned long long memoire_bandes(const Entete_PNM *entete, const Filtre_prepare *filtre, int lignes_par_bande, int halo, Mode_execution mode){
+    unsigned long long nbr_canaux = (entete->format==3) ? 3 : 1, memoire;
+    int hauteur = lignes_par_bande + 2*halo;
+
+    if(hauteur > entete->nbr_ligne)
+        hauteur = entete->nbr_ligne;
+    //tampon et son filtrage, lignes du halo conservées
+    memoire = memoire_lignes(entete, filtre, hauteur)
+              + 2ULL * halo * entete->nbr_colonne * nbr_canaux * sizeof(unsigned short);
+    //position de chaque bande dans le fichier
+    if(mode==execution_bandes_inversees)
+        memoire += (unsigned long long)(entete->nbr_ligne / lignes_par_bande + 1) * sizeof(long);
+    return memoire;
+}
+
+static FILE *ouvre_sortie(PNM *bande, int nbr_ligne, char *filename_output){
+    Entete_PNM entete;
+    FILE *sortie;
+
+    entete.format = acces_format_PNM(bande);
+    entete.nbr_ligne = nbr_ligne;
+    entete.nbr_colonne = acces_nbr_colonne_PNM(bande);
+    entete.valeur_max = acces_valeur_max_PNM(bande);
+
+    if(verifie_validite_filename(filename_output)!=0 || adapte_extension_format(filename_output, entete.format)!=0)
+        return NULL;
+    sortie = ouvre_fichier_image(filename_output, "w");
+    if(sortie==NULL)
+        return NULL;
+    if(ecrit_en_tete_PNM(&entete, sortie)!=0){
+        ferme_fichier_image(sortie);
+        return NULL;
+    }
+    return sortie;
+}
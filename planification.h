@@ -0,0 +1,127 @@
+/**
+ * \file planification.h
+ * \brief Ce fichier contient les déclarations du planificateur d'exécution sous budget mémoire.
+ *
+ * À partir des dimensions lues dans l'en tête, le planificateur estime la
+ * mémoire du chargement complet (valeurs, tables de pixel, contenu du
+ * fichier pour l'analyse parallèle, tampons d'écriture et mémoire de travail
+ * du filtre). Si elle dépasse le budget, l'image est traitée par bandes de
+ * lignes: en flux pour un filtre ponctuel, ou en tuiles pleine largeur
+ * entourées d'un halo de lignes voisines pour un filtre par fenêtre. Un
+ * retournement ou un miroir vertical, qui ne peuvent écrire leur première
+ * ligne qu'après avoir lu la dernière, lisent les bandes de la dernière à
+ * la première grâce à un index des positions de bande dans le fichier.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __PLANIFICATION__
+#define __PLANIFICATION__
+
+#include "pnm.h"
+#include "registre.h"
+
+/**
+ * \enum Mode_execution
+ * \brief Manière de traiter l'image
+ */
+typedef enum {
+    execution_memoire,//image entière chargée
+    execution_flux_lignes,//bandes de lignes indépendantes
+    execution_tuiles,//bandes de lignes entourées d'un halo
+    execution_bandes_inversees//bandes indépendantes lues de la dernière à la première
+} Mode_execution;
+
+/**
+ * \struct Plan_execution
+ * \brief Plan choisi par planifie_execution
+ */
+typedef struct {
+    Mode_execution mode;
+    int lignes_par_bande;//lignes produites par bande (toute l'image en mémoire)
+    int halo;//lignes voisines lues au-dessus et au-dessous de chaque bande
+    unsigned long long memoire_estimee;//en octets
+} Plan_execution;
+
+/**
+ * \fn planifie_execution(Plan_execution *plan, const Entete_PNM *entete, const Filtre_prepare *filtre, int bandes_possibles, unsigned long long budget)
+ * \brief Choisit le traitement en mémoire s'il respecte le budget, sinon les plus grandes bandes qui le respectent
+ *
+ * \param plan pointeur sur le plan à remplir
+ * \param entete l'en tête de l'image input, lu par lit_en_tete_PNM
+ * \param filtre le filtre préparé, NULL si aucun filtre n'est appliqué
+ * \param bandes_possibles 0 si l'image entière doit être en mémoire (région d'intérêt, comparaison)
+ * \param budget la mémoire disponible en octets, 0 pour ne pas la limiter
+ *
+ * \pre plan!=NULL, entete!=NULL
+ * \post plan complété
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Même les plus petites bandes dépassent le budget \n
+ *      -2 Le chargement complet dépasse le budget mais l'image entière est nécessaire
+ *         (filtre global autre qu'une inversion des lignes, ou input compressé)
+ *
+ */
+int planifie_execution(Plan_execution *plan, const Entete_PNM *entete, const Filtre_prepare *filtre, int bandes_possibles, unsigned long long budget);
+
+/**
+ * \fn execute_plan_bandes(const Plan_execution *plan, const Filtre_prepare *filtre, char *filename, char *filename_output)
+ * \brief Applique filtre à filename bande par bande et écrit le résultat dans filename_output
+ *
+ * Les lignes sont lues une seule fois: les lignes du halo communes à deux
+ * bandes sont conservées, avant filtrage, pour la bande suivante. Seules
+ * les lignes propres à chaque bande sont écrites. En execution_bandes_inversees,
+ * le fichier est d'abord indexé (indexe_lignes_PNM), puis chaque bande est
+ * relue directement à sa position, de la dernière à la première.
+ *
+ * \param plan un plan execution_flux_lignes, execution_tuiles ou execution_bandes_inversees
+ * \param filtre le filtre préparé
+ * \param filename le fichier input
+ * \param filename_output le fichier output, dont l'extension est adaptée au format du résultat
+ *
+ * \pre plan!=NULL, filtre!=NULL, filename!=NULL, filename_output!=NULL
+ * \post filename_output contient l'image filtrée
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Lecture de filename impossible \n
+ *      -2 Erreur d'allocation de mémoire \n
+ *      -3 Le filtre ne peut être appliqué \n
+ *      -4 Écriture de filename_output impossible
+ *
+ */
+int execute_plan_bandes(const Plan_execution *plan, const Filtre_prepare *filtre, char *filename, char *filename_output);
+
+/**
+ * \fn lit_taille_memoire(const char *texte, unsigned long long *taille)
+ * \brief Lit une taille mémoire de la forme <nombre>[k|M|G] (octets, kio, Mio, Gio)
+ *
+ * \param texte la taille à lire
+ * \param taille pointeur recevant la taille en octets
+ *
+ * \pre texte!=NULL, taille!=NULL
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Taille incorrecte ou nulle
+ *
+ */
+int lit_taille_memoire(const char *texte, unsigned long long *taille);
+
+/**
+ * \fn affiche_plan(const Plan_execution *plan, unsigned long long budget)
+ * \brief Affiche le plan choisi et la mémoire estimée (mode verbeux)
+ *
+ * \param plan pointeur sur le plan à afficher
+ * \param budget le budget mémoire en octets, 0 si illimité
+ *
+ * \pre plan!=NULL
+ *
+ */
+void affiche_plan(const Plan_execution *plan, unsigned long long budget);
+
+#endif
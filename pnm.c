@@ -6,13 +6,41 @@
  * 
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 
 #include "pnm.h"
 #include "filtre.h"
+#include "trace.h"
+#include "compression.h"
+
+/**
+ * Taille (en octets) à partir de laquelle le contenu ASCII d'une image est
+ * découpé en morceaux analysés en parallèle
+ */
+#define SEUIL_PARSE_PARALLELE (1 << 20)
+
+/**
+ * Taille minimale (en octets) d'un morceau analysé par un thread
+ */
+#define TAILLE_MIN_MORCEAU (256 << 10)
+
+/**
+ * Nombre de valeurs à partir duquel les lignes d'une image sont mises en
+ * forme en parallèle lors de l'écriture
+ */
+#define SEUIL_ECRITURE_PARALLELE (1 << 18)
 
 /**
  * \struct PNM_t
@@ -22,125 +50,212 @@ struct PNM_t {
    int format;
    int nbr_ligne, nbr_colonne;
    unsigned int valeur_max;
-   unsigned short ***valeurs_pixel;
+   unsigned short ***valeurs_pixel;//tables de pixel, construites au premier appel de acces_valeurs_pixel_PNM (NULL avant)
+   int nbr_canaux;//nombre de valeurs stockées par pixel (3 si PPM à la construction, 1 sinon)
+   unsigned short *echantillons;//stockage contigu des valeurs, NULL pour une vue sur une autre image
+   unsigned short *origine;//première valeur du pixel (0, 0), dans echantillons ou dans l'image d'une vue
+   long pas_ligne;//nombre de valeurs entre le début de deux lignes successives
 };
 
+/**
+ * \struct Morceau_ascii
+ * \brief Plage d'octets du contenu ASCII d'une image analysée par un thread
+ */
+typedef struct {
+   const char *debut, *fin;
+   PNM *image;
+   unsigned long premier_indice;//indice (en nombre de valeurs) de la première valeur du morceau
+   unsigned long nbr_valeurs;//nombre de valeurs contenues dans le morceau
+   unsigned long nbr_valeurs_image;//nombre total de valeurs de l'image
+   int ecriture;//0: comptage des valeurs, 1: écriture des valeurs dans l'image
+   int erreur;
+} Morceau_ascii;
+
+/**
+ * \struct Bande_ecriture
+ * \brief Bande de lignes d'une image mise en forme en texte par un thread
+ */
+typedef struct {
+   PNM *image;
+   int premiere_ligne, derniere_ligne;//lignes [premiere_ligne, derniere_ligne[
+   char *texte;
+   size_t taille;
+} Bande_ecriture;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static int alloue_tables_pixel(PNM *image);
+static inline unsigned short *pixel_PNM(PNM *image, int ligne, int colonne);
+static int charge_valeurs_fenetre(PNM *image, FILE *fichier, int nbr_colonne_fichier, int x, int y);
+static int charge_valeurs_sequentiel(PNM *image, FILE *fichier);
+static int charge_valeurs_parallele(PNM *image, char *contenu, long taille);
+static void execute_morceaux_ascii(Morceau_ascii *morceaux, int nbr_morceaux);
+static void *parcourt_morceau_ascii(void *arg);
+static int ecrit_image_sequentiel(PNM *image, FILE *fichier);
+static int ecrit_image_parallele(PNM *image, FILE *fichier);
+static void *met_en_forme_bande(void *arg);
+static int ecrit_tampons(int descripteur, struct iovec *tampons, int nbr_tampons);
+
 
 int load_pnm(PNM **image, char* filename) {
-   int type_image, extension_fichier;
-   int nbr_ligne, nbr_colonne;
-   unsigned int valeur_max;
+   Entete_PNM entete;
+   int erreur;
    assert(filename!=NULL);
 
-   FILE* fichier = fopen(filename, "r");//ouverture du fichier
+   FILE *fichier = ouvre_fichier_PNM(filename, &entete, &erreur);
+   if(fichier==NULL)
+      return erreur;
+
+   /*allocation dynamique d'une struct PNM et allocation du tableau qui contiendra les valeurs de chaque pixel de l'image
+      remplissage de la structure (informations + valeurs de chaque pixel)*/
+   *image = constructeur_PNM(entete.nbr_ligne, entete.nbr_colonne, entete.format, entete.valeur_max);
+   if (*image==NULL){
+      printf("Allocation de mémoire impossible.\n");
+      ferme_fichier_image(fichier);
+      return -1;
+   }
+
+   if(charge_valeurs_fichier(*image, fichier)==-1){
+      libere_PNM(image);
+      ferme_fichier_image(fichier);
+      printf("Erreur lors du chargement de l'image.\n");
+      return -2;
+   }
+
+   ferme_fichier_image(fichier);
+   return 0;
+}
+
+int load_pnm_fenetre(PNM **image, char *filename, int x, int y, int largeur, int hauteur){
+   Entete_PNM entete;
+   int erreur;
+   assert(image!=NULL && filename!=NULL);
+
+   FILE *fichier = ouvre_fichier_PNM(filename, &entete, &erreur);
+   if(fichier==NULL)
+      return erreur;
+
+   if(x<0 || y<0 || largeur<=0 || hauteur<=0 || x+largeur>entete.nbr_colonne || y+hauteur>entete.nbr_ligne){
+      printf("La fenêtre %d,%d,%d,%d dépasse les dimensions de l'image %s.\n", x, y, largeur, hauteur, filename);
+      ferme_fichier_image(fichier);
+      return -4;
+   }
+
+   //seule la fenêtre est allouée
+   *image = constructeur_PNM(hauteur, largeur, entete.format, entete.valeur_max);
+   if (*image==NULL){
+      printf("Allocation de mémoire impossible.\n");
+      ferme_fichier_image(fichier);
+      return -1;
+   }
+
+   if(charge_valeurs_fenetre(*image, fichier, entete.nbr_colonne, x, y)==-1){
+      libere_PNM(image);
+      ferme_fichier_image(fichier);
+      printf("Erreur lors du chargement de l'image.\n");
+      return -2;
+   }
+
+   ferme_fichier_image(fichier);
+   return 0;
+}
+
+FILE *ouvre_fichier_PNM(char *filename, Entete_PNM *entete, int *erreur){
+   assert(filename!=NULL && entete!=NULL && erreur!=NULL);
+   int extension_fichier;
+   unsigned long long trace = debut_trace();
+
+   FILE* fichier = ouvre_fichier_image(filename, "r");//ouverture du fichier
    if (fichier==NULL){
       printf("Impossible d'ouvrir le fichier %s.\n", filename);
-      return -2;
+      *erreur = -2;
+      return NULL;
    }
 
    //Vérifications format
-   if (verifie_nombre_magique(&type_image, fichier)==-1){
+   if (verifie_nombre_magique(&entete->format, fichier)==-1){
       printf("L'en tête de l'image est malformée.\n");
-      fclose(fichier);
-      return -3;
+      ferme_fichier_image(fichier);
+      *erreur = -3;
+      return NULL;
    }
 
    //vérifie que le format lu dans l'en tête du fichier correspond bien à l'extension de filename
-   if (verifie_correspondance_extension_format(type_image, filename, &extension_fichier)==-1){
+   if (verifie_correspondance_extension_format(entete->format, filename, &extension_fichier)==-1){
       printf("L'extension de %s ne correspond pas au format de l'en tête.\n", filename);
-      fclose(fichier);
-      return -2;
+      ferme_fichier_image(fichier);
+      *erreur = -2;
+      return NULL;
    }
    //enregistrement dimensions
-   if(lit_dimensions_image(&nbr_ligne, &nbr_colonne, fichier)==-1){
+   if(lit_dimensions_image(&entete->nbr_ligne, &entete->nbr_colonne, fichier)==-1){
       printf("En tête de fichier mal formée. Impossible de lire les dimensions.\n");
-      fclose(fichier);
-      return -3;
+      ferme_fichier_image(fichier);
+      *erreur = -3;
+      return NULL;
    }
 
    //enregistrement valeur max
-   if(type_image==2 || type_image==3){
-      if(lit_valeur_max(&valeur_max, fichier)==-1){
+   entete->valeur_max = 1;
+   if(entete->format==2 || entete->format==3){
+      if(lit_valeur_max(&entete->valeur_max, fichier)==-1){
          printf("En tête de fichier mal formée. Impossible de lire la valeur max.\n");
-         fclose(fichier);
-         return -3;
+         ferme_fichier_image(fichier);
+         *erreur = -3;
+         return NULL;
       }
    }
 
-   /*allocation dynamique d'une struct PNM et allocation du tableau qui contiendra les valeurs de chaque pixel de l'image
-      remplissage de la structure (informations + valeurs de chaque pixel)*/
-   *image = constructeur_PNM(nbr_ligne, nbr_colonne, type_image, valeur_max);
-   if (*image==NULL){
-      printf("Allocation de mémoire impossible.\n");
-      fclose(fichier);
-      return -1;
-   }
+   fin_trace("en_tete", trace);
+   return fichier;
+}
 
-   if(charge_valeurs_fichier(*image, fichier)==-1){
-      libere_PNM(image);
-      printf("Erreur lors du chargement de l'image.\n");
+int lit_en_tete_PNM(Entete_PNM *entete, char *filename){
+   assert(entete!=NULL && filename!=NULL);
+
+   FILE *fichier = ouvre_fichier_image(filename, "r");
+   if(fichier==NULL){
+      printf("Impossible d'ouvrir le fichier %s.\n", filename);
       return -2;
    }
 
-   fclose(fichier);
+   //seul l'en tête est lu, les valeurs de pixel ne sont jamais parcourues
+   entete->valeur_max = 1;
+   if(verifie_nombre_magique(&entete->format, fichier)==-1 ||
+      lit_dimensions_image(&entete->nbr_ligne, &entete->nbr_colonne, fichier)==-1 ||
+      ((entete->format==2 || entete->format==3) && lit_valeur_max(&entete->valeur_max, fichier)==-1)){
+      printf("L'en tête de l'image est malformée.\n");
+      ferme_fichier_image(fichier);
+      return -3;
+   }
+
+   //un flux décompressé n'est pas positionnable: position et taille indisponibles
+   if(est_compresse(filename)){
+      entete->position_valeurs = -1;
+      entete->taille_fichier = -1;
+      ferme_fichier_image(fichier);
+      return 0;
+   }
+
+   //un unique caractère d'espacement sépare l'en tête des valeurs de pixel
+   fgetc(fichier);
+   entete->position_valeurs = ftell(fichier);
+   if(fseek(fichier, 0, SEEK_END)==0)
+      entete->taille_fichier = ftell(fichier);
+   else
+      entete->taille_fichier = -1;
+
+   ferme_fichier_image(fichier);
    return 0;
 }
 
 PNM *constructeur_PNM(int nbr_ligne,int nbr_colonne, int format, unsigned int valeur_max){
-   int i, j;
-
-   //malloc la matrice et chaque élément de celle-ci
    PNM *image = malloc(sizeof(PNM));
    if (image==NULL)
       return NULL;
 
-   //malloc du pointeur vers le tableau de pointeur qui vont eux mêmes pointer vers un tableau allant de 1 short(PBM, PGM) à 3 short(PPM)
-   image->valeurs_pixel = malloc(nbr_ligne * sizeof(unsigned short**));
-   if(image->valeurs_pixel==NULL){
-      free(image);//libere la struct si impossibilité d'allouer de la mémoire pour le tableau de pointeurs de short
-      return NULL;
-   }
-
-   //allocation des pointeurs vers short (1 si PBM,PGM; 3 si PPM)
-   for(i=0; i<nbr_ligne; i++){
-      image->valeurs_pixel[i] = malloc(nbr_colonne * sizeof(unsigned short*));//allocation d'un pointeur d'une ligne
-      if (image->valeurs_pixel[i]==NULL){//si échec de l'allocation de la ligne, free de tout ce qui a été allouer avant cette ligne
-         for(i--; i>=0; i--){//free reste du tableau avant la ligne n'ayant pu être malloc
-            for(j=0; j<nbr_colonne; j++)
-               free(image->valeurs_pixel[i][j]);
-            free(image->valeurs_pixel[i]);
-         }
-         free(image->valeurs_pixel);
-         free(image);
-         image=NULL;
-         return NULL;//sortie de la fonction car échec d'allocation d'un pointeur de ligne
-      }
-      else{//si allocation de la ligne avec succès, allocation des pointeurs de chaque élément de cette ligne
-         for(j=0; j<nbr_colonne; j++){
-            if(image->format==3)//si PPM, allocation de 3 cases pour pouvoir enregister 3 valeurs, représentant les correspondances en RGB de chaque pixel
-               image->valeurs_pixel[i][j] = malloc(3 * sizeof(unsigned short));
-            else//PBM, PGM : un seul short nécessaire pour chaque pixel
-               image->valeurs_pixel[i][j] = malloc(sizeof(unsigned short));
-
-            if(image->valeurs_pixel[i][j]==NULL){//si échec de l'allocation de la case du/des short, alors free de ce qui a déjà été alloué
-               for(j--; j>=0; j--)//free éléments de la colonne avant l'élément n'ayant pu être malloc
-                  free(image->valeurs_pixel[i][j]);
-               free(image->valeurs_pixel[i]);
-
-               for(i--;i>=0; i--){//free reste du tableau avant la colonne dans laquelle un élément n'a pu être malloc
-                  for(j=0; j<nbr_colonne; j++)
-                     free(image->valeurs_pixel[i][j]);
-                  free(image->valeurs_pixel[i]);
-               }
-            free(image->valeurs_pixel);
-            free(image);
-            image=NULL;
-            return NULL;//sortie de la fonction car échec de l'allocation de la case de short du tableau
-            }
-         }
-      }
-   }
-
    //initialisation des informations de l'image dans la struct PNM
    image->nbr_ligne = nbr_ligne;
    image->nbr_colonne = nbr_colonne;
@@ -150,13 +265,222 @@ PNM *constructeur_PNM(int nbr_ligne,int nbr_colonne, int format, unsigned int va
    else
       image->valeur_max = valeur_max;
 
+   //PPM: 3 valeurs (RGB) par pixel; PBM, PGM: une seule valeur
+   image->nbr_canaux = (format==3) ? 3 : 1;
+
+   //toutes les valeurs sont stockées dans un seul bloc, ligne après ligne
+   image->echantillons = malloc((size_t)nbr_ligne * nbr_colonne * image->nbr_canaux * sizeof(unsigned short));
+   if(image->echantillons==NULL){
+      free(image);
+      return NULL;
+   }
+
+   image->origine = image->echantillons;
+   image->pas_ligne = (long)nbr_colonne * image->nbr_canaux;
+   image->valeurs_pixel = NULL;
+
    return image;
 }
 
+PNM *vue_PNM(PNM *image, int x, int y, int largeur, int hauteur){
+   assert(image!=NULL);
+   if(x<0 || y<0 || largeur<=0 || hauteur<=0 || x+largeur>image->nbr_colonne || y+hauteur>image->nbr_ligne)
+      return NULL;
+
+   PNM *vue = malloc(sizeof(PNM));
+   if(vue==NULL)
+      return NULL;
+
+   vue->nbr_ligne = hauteur;
+   vue->nbr_colonne = largeur;
+   vue->format = image->format;
+   vue->valeur_max = image->valeur_max;
+   vue->nbr_canaux = image->nbr_canaux;
+   vue->echantillons = NULL;//les valeurs appartiennent à image
+
+   //les lignes de la vue sont celles de image, à partir du pixel (y, x): aucune table n'est allouée
+   vue->origine = pixel_PNM(image, y, x);
+   vue->pas_ligne = image->pas_ligne;
+   vue->valeurs_pixel = NULL;
+
+   return vue;
+}
+
+int harmonise_vue_PNM(PNM *vue, PNM *image){
+   assert(vue!=NULL && image!=NULL);
+   unsigned short valeur, *pixel;
+
+   if(vue->format==image->format)
+      return 0;
+   //un filtre ne peut qu'abaisser le format d'une vue (PPM -> PGM -> PBM)
+   if(vue->format>image->format)
+      return -1;
+
+   for(int i=0; i<vue->nbr_ligne; i++){
+      for(int j=0; j<vue->nbr_colonne; j++){
+         pixel = pixel_PNM(vue, i, j);
+         valeur = pixel[0];
+         if(vue->format==1)//PBM: 1 représente un pixel noir
+            valeur = (valeur==1) ? 0 : image->valeur_max;
+         for(int x=0; x<vue->nbr_canaux; x++)
+            pixel[x] = valeur;
+      }
+   }
+   vue->format = image->format;
+   vue->valeur_max = image->valeur_max;
+
+   return 0;
+}
+
+PNM *copie_PNM(PNM *image){
+   assert(image!=NULL);
+   PNM *copie = constructeur_PNM(image->nbr_ligne, image->nbr_colonne, image->format, image->valeur_max);
+   if(copie==NULL)
+      return NULL;
+
+   //lignes contiguës de même pas recopiées d'un bloc, sinon pixel par pixel
+   for(int i=0; i<image->nbr_ligne; i++){
+      if(image->nbr_canaux==copie->nbr_canaux)
+         memcpy(pixel_PNM(copie, i, 0), pixel_PNM(image, i, 0), (size_t)image->nbr_colonne * image->nbr_canaux * sizeof(unsigned short));
+      else{
+         for(int j=0; j<image->nbr_colonne; j++)
+            *pixel_PNM(copie, i, j) = *pixel_PNM(image, i, j);
+      }
+   }
+
+   return copie;
+}
+
+int reutilise_PNM(PNM *image, int nbr_ligne, int nbr_colonne, int format, unsigned int valeur_max){
+   assert(image!=NULL);
+
+   if(image->echantillons==NULL || image->nbr_ligne!=nbr_ligne || image->nbr_colonne!=nbr_colonne ||
+      image->nbr_canaux!=((format==3) ? 3 : 1))
+      return -1;
+
+   image->format = format;
+   image->valeur_max = (format==1) ? 1 : valeur_max;
+   return 0;
+}
+
+static int alloue_tables_pixel(PNM *image){
+   unsigned short ***lignes, **pixels;
+
+   //un pointeur par ligne, puis un pointeur par pixel vers ses valeurs dans le stockage contigu
+   lignes = malloc((image->nbr_ligne>0 ? image->nbr_ligne : 1) * sizeof(unsigned short**));
+   if(lignes==NULL)
+      return -1;
+   pixels = malloc(((size_t)image->nbr_ligne * image->nbr_colonne + 1) * sizeof(unsigned short*));
+   if(pixels==NULL){
+      free(lignes);
+      return -1;
+   }
+
+   for(int i=0; i<image->nbr_ligne; i++){
+      lignes[i] = pixels + (size_t)i * image->nbr_colonne;
+      for(int j=0; j<image->nbr_colonne; j++)
+         lignes[i][j] = pixel_PNM(image, i, j);
+   }
+   lignes[0] = pixels;//libere_PNM libère pixels par la première ligne, même pour une image vide
+   image->valeurs_pixel = lignes;
+
+   return 0;
+}
+
+static inline unsigned short *pixel_PNM(PNM *image, int ligne, int colonne){
+   return image->origine + (size_t)ligne * image->pas_ligne + (size_t)colonne * image->nbr_canaux;
+}
+
 int charge_valeurs_fichier(PNM *image, FILE *fichier){
    assert(image!=NULL && fichier!=NULL);
+   long debut, fin;
+   char *contenu;
+   int resultat;
+
+   //les petits fichiers et les flux non positionnables (dont les fichiers .gz) sont lus séquentiellement
+   if((debut = ftell(fichier))<0 || fseek(fichier, 0, SEEK_END)!=0)
+      return charge_valeurs_sequentiel(image, fichier);
+   fin = ftell(fichier);
+   if(fseek(fichier, debut, SEEK_SET)!=0)
+      return -1;
+   if(fin-debut < SEUIL_PARSE_PARALLELE || nombre_threads_disponibles()==1)
+      return charge_valeurs_sequentiel(image, fichier);
+
+   //lecture de tout le contenu restant (les valeurs de pixel) en mémoire
+   contenu = malloc(fin-debut+1);
+   if(contenu==NULL)
+      return charge_valeurs_sequentiel(image, fichier);
+   if(fread(contenu, 1, fin-debut, fichier)!=(size_t)(fin-debut)){
+      free(contenu);
+      return -1;
+   }
+   contenu[fin-debut] = '\0';
+
+   resultat = charge_valeurs_parallele(image, contenu, fin-debut);
+   free(contenu);
+   return resultat;
+}
+
+int charge_lignes_fichier(PNM *image, FILE *fichier){
+   assert(image!=NULL && fichier!=NULL);
+
+   //les lignes suivantes du fichier ont exactement la largeur de image
+   return charge_valeurs_fenetre(image, fichier, image->nbr_colonne, 0, 0);
+}
+
+int indexe_lignes_PNM(char *filename, const Entete_PNM *entete, int pas, long *positions){
+   assert(filename!=NULL && entete!=NULL && pas>=1 && positions!=NULL);
+   int descripteur, nbr_bandes = (entete->nbr_ligne + pas - 1) / pas, bande = 1;
+   unsigned long nbr_canaux = (entete->format==3) ? 3 : 1, nbr_valeurs = 0;
+   unsigned long valeurs_bande = nbr_canaux * entete->nbr_colonne * (unsigned long)pas;
+   struct stat etat;
+   const char *contenu, *c, *fin;
+   unsigned long long trace = debut_trace();
+
+   if(est_compresse(filename) || entete->position_valeurs < 0)
+      return -1;
+   descripteur = open(filename, O_RDONLY);
+   if(descripteur<0)
+      return -1;
+   if(fstat(descripteur, &etat)!=0 || etat.st_size <= entete->position_valeurs){
+      close(descripteur);
+      return -1;
+   }
+   contenu = mmap(NULL, etat.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0);
+   close(descripteur);
+   if(contenu==MAP_FAILED)
+      return -1;
+   posix_madvise((void *)contenu, etat.st_size, POSIX_MADV_SEQUENTIAL);
+
+   //les valeurs sont seulement délimitées, pas analysées: la bande suivante commence après la dernière valeur de la précédente
+   positions[0] = entete->position_valeurs;
+   c = contenu + entete->position_valeurs;
+   fin = contenu + etat.st_size;
+   while(c < fin && bande < nbr_bandes){
+      if(*c=='#'){//commentaire: ignore la fin de la ligne
+         while(c < fin && *c!='\n')
+            c++;
+         continue;
+      }
+      if(isspace((unsigned char)*c)){
+         c++;
+         continue;
+      }
+      while(c < fin && !isspace((unsigned char)*c) && *c!='#')
+         c++;
+      if(++nbr_valeurs == bande * valeurs_bande)
+         positions[bande++] = c - contenu;
+   }
+   munmap((void *)contenu, etat.st_size);
+
+   fin_trace("indexation", trace);
+   return (bande==nbr_bandes) ? 0 : -1;
+}
+
+static int charge_valeurs_sequentiel(PNM *image, FILE *fichier){
    char stockage_valeur_fichier[100];
    int i, j, nbr_valeur_ppm = 0;
+   unsigned long long trace = debut_trace();
 
    //initialisation des valeurs du tableau de pixel représentant l'image
    for (i = 0; i < image->nbr_ligne; i++){
@@ -164,16 +488,14 @@ int charge_valeurs_fichier(PNM *image, FILE *fichier){
          if(fscanf(fichier, "%s", stockage_valeur_fichier)==0)
             return -1;
          if (stockage_valeur_fichier[0] != '#'){
-            if (atoi(stockage_valeur_fichier) > (int)image->valeur_max){
-               libere_PNM(&image);
+            if (atoi(stockage_valeur_fichier) > (int)image->valeur_max)
                return -1;
-            }
             if (image->format == 1 || image->format == 2){
-               image->valeurs_pixel[i][j][0] = atoi(stockage_valeur_fichier);
+               pixel_PNM(image, i, j)[0] = atoi(stockage_valeur_fichier);
                j++;
             }
             else{
-               image->valeurs_pixel[i][j][nbr_valeur_ppm] = atoi(stockage_valeur_fichier);
+               pixel_PNM(image, i, j)[nbr_valeur_ppm] = atoi(stockage_valeur_fichier);
                if (nbr_valeur_ppm == 2)
                   j++;
                nbr_valeur_ppm++;
@@ -185,9 +507,192 @@ int charge_valeurs_fichier(PNM *image, FILE *fichier){
       }
    }
 
+   fin_trace("analyse_sequentielle", trace);
+   return 0;
+}
+
+static int charge_valeurs_fenetre(PNM *image, FILE *fichier, int nbr_colonne_fichier, int x, int y){
+   int c, nbr_canaux = (image->format==3) ? 3 : 1, canal = 0, ligne = 0, colonne = 0;
+   unsigned long valeur;
+   unsigned long long trace = debut_trace();
+
+   //lecture des valeurs jusqu'à la dernière ligne de la fenêtre, les lignes suivantes ne sont jamais lues
+   while(ligne < y + image->nbr_ligne){
+      c = getc(fichier);
+      if(c==EOF)
+         return -1;
+      if(c=='#'){//commentaire: ignore la fin de la ligne
+         while(c!='\n' && c!=EOF)
+            c = getc(fichier);
+         continue;
+      }
+      if(isspace(c))
+         continue;
+
+      valeur = 0;
+      while(c!=EOF && !isspace(c) && c!='#'){
+         if(!isdigit(c))
+            return -1;
+         if(valeur <= image->valeur_max)
+            valeur = valeur*10 + (c-'0');
+         c = getc(fichier);
+      }
+      if(c=='#')
+         ungetc(c, fichier);
+      if(valeur > image->valeur_max)
+         return -1;
+
+      if(ligne>=y && colonne>=x && colonne<x+image->nbr_colonne)
+         pixel_PNM(image, ligne-y, colonne-x)[canal] = valeur;
+      if(++canal==nbr_canaux){
+         canal = 0;
+         if(++colonne==nbr_colonne_fichier){
+            colonne = 0;
+            ligne++;
+         }
+      }
+   }
+
+   fin_trace("analyse_lignes", trace);
    return 0;
 }
 
+int nombre_threads_disponibles(void){
+   long nbr = sysconf(_SC_NPROCESSORS_ONLN);
+
+   if(nbr<1)
+      return 1;
+   if(nbr>NBR_MAX_THREADS)
+      return NBR_MAX_THREADS;
+   return (int)nbr;
+}
+
+static int charge_valeurs_parallele(PNM *image, char *contenu, long taille){
+   Morceau_ascii morceaux[NBR_MAX_THREADS];
+   int nbr_morceaux = nombre_threads_disponibles(), i, erreur = 0;
+   unsigned long nbr_canaux = (image->format==3) ? 3 : 1, cumul = 0;
+   const char *position = contenu, *fin_contenu = contenu + taille, *limite;
+
+   if(nbr_morceaux > taille/TAILLE_MIN_MORCEAU)
+      nbr_morceaux = taille/TAILLE_MIN_MORCEAU;
+   if(nbr_morceaux<1)
+      nbr_morceaux = 1;
+
+   /*découpe du contenu en morceaux alignés sur des fins de ligne: un commentaire
+   se termine toujours à la fin de sa ligne, chaque morceau commence donc hors commentaire*/
+   for(i=0; i<nbr_morceaux && position<fin_contenu; i++){
+      limite = (i==nbr_morceaux-1) ? fin_contenu : contenu + (taille/nbr_morceaux)*(i+1);
+      if(limite<position)
+         limite = position;
+      while(limite<fin_contenu && *limite!='\n')
+         limite++;
+      if(limite<fin_contenu)
+         limite++;
+
+      morceaux[i].debut = position;
+      morceaux[i].fin = limite;
+      morceaux[i].image = image;
+      morceaux[i].premier_indice = 0;
+      morceaux[i].nbr_valeurs = 0;
+      morceaux[i].nbr_valeurs_image = nbr_canaux * image->nbr_ligne * image->nbr_colonne;
+      morceaux[i].ecriture = 0;
+      morceaux[i].erreur = 0;
+      position = limite;
+   }
+   nbr_morceaux = i;
+
+   //premier passage: comptage des valeurs de chaque morceau
+   execute_morceaux_ascii(morceaux, nbr_morceaux);
+
+   //somme préfixe: indice de la première valeur de chaque morceau
+   for(i=0; i<nbr_morceaux; i++){
+      morceaux[i].premier_indice = cumul;
+      morceaux[i].ecriture = 1;
+      cumul += morceaux[i].nbr_valeurs;
+   }
+   if(cumul < nbr_canaux * image->nbr_ligne * image->nbr_colonne)
+      return -1;
+
+   //second passage: écriture des valeurs à leur place dans l'image
+   for(i=0; i<nbr_morceaux; i++){
+      if(morceaux[i].premier_indice >= morceaux[i].nbr_valeurs_image)
+         break;
+   }
+   nbr_morceaux = i;
+   execute_morceaux_ascii(morceaux, nbr_morceaux);
+   for(i=0; i<nbr_morceaux; i++){
+      if(morceaux[i].erreur)
+         erreur = 1;
+   }
+
+   return erreur ? -1 : 0;
+}
+
+static void execute_morceaux_ascii(Morceau_ascii *morceaux, int nbr_morceaux){
+   pthread_t threads[NBR_MAX_THREADS];
+   int lance[NBR_MAX_THREADS];
+
+   //un morceau dont le thread n'a pu être créé est traité par le thread appelant
+   for(int i=0; i<nbr_morceaux; i++){
+      lance[i] = (pthread_create(&threads[i], NULL, parcourt_morceau_ascii, &morceaux[i])==0);
+      if(!lance[i])
+         parcourt_morceau_ascii(&morceaux[i]);
+   }
+   for(int i=0; i<nbr_morceaux; i++){
+      if(lance[i])
+         pthread_join(threads[i], NULL);
+   }
+}
+
+static void *parcourt_morceau_ascii(void *arg){
+   Morceau_ascii *morceau = arg;
+   PNM *image = morceau->image;
+   const char *c = morceau->debut;
+   unsigned long indice = morceau->premier_indice, nbr_valeurs = 0, valeur, pixel;
+   unsigned long nbr_canaux = (image->format==3) ? 3 : 1;
+   unsigned long long trace = debut_trace();
+
+   while(c < morceau->fin){
+      if(*c=='#'){//commentaire: ignore la fin de la ligne
+         while(c < morceau->fin && *c!='\n')
+            c++;
+         continue;
+      }
+      if(isspace((unsigned char)*c)){
+         c++;
+         continue;
+      }
+
+      //lecture d'une valeur
+      valeur = 0;
+      while(c < morceau->fin && !isspace((unsigned char)*c) && *c!='#'){
+         if(!isdigit((unsigned char)*c))
+            morceau->erreur = morceau->ecriture;
+         else if(valeur <= image->valeur_max)
+            valeur = valeur*10 + (*c-'0');
+         c++;
+      }
+      nbr_valeurs++;
+
+      if(morceau->ecriture){
+         if(indice >= morceau->nbr_valeurs_image)
+            break;//les valeurs au-delà de la taille de l'image sont ignorées
+         if(valeur > image->valeur_max || morceau->erreur){
+            morceau->erreur = 1;
+            break;
+         }
+         pixel = indice / nbr_canaux;
+         pixel_PNM(image, pixel / image->nbr_colonne, pixel % image->nbr_colonne)[indice % nbr_canaux] = valeur;
+         indice++;
+      }
+   }
+
+   if(!morceau->ecriture)
+      morceau->nbr_valeurs = nbr_valeurs;
+   fin_trace(morceau->ecriture ? "analyse_morceau" : "comptage_morceau", trace);
+   return NULL;
+}
+
 int acces_nbr_ligne_PNM(PNM *image){
    assert(image!=NULL);
 
@@ -215,18 +720,32 @@ unsigned int acces_valeur_max_PNM(PNM *image){
 unsigned short ***acces_valeurs_pixel_PNM(PNM *image){
    assert(image!=NULL);
 
+   if(image->valeurs_pixel==NULL && alloue_tables_pixel(image)==-1)
+      return NULL;
    return (image->valeurs_pixel);
 }
 
+int acces_nbr_canaux_PNM(PNM *image){
+   assert(image!=NULL);
+
+   return image->nbr_canaux;
+}
+
+unsigned short *acces_ligne_PNM(PNM *image, int numero_ligne){
+   assert(image!=NULL && numero_ligne>=0 && numero_ligne<image->nbr_ligne);
+
+   return pixel_PNM(image, numero_ligne, 0);
+}
+
 void changer_valeur_pixel_PNM(PNM *image, int numero_ligne, int numero_colonne, unsigned short valeur[]){
    assert(image!=NULL);
    
    if(image->format==3){
       for(int i=0; i<3; i++)
-         image->valeurs_pixel[numero_ligne][numero_colonne][i]=valeur[i];
+         pixel_PNM(image, numero_ligne, numero_colonne)[i]=valeur[i];
    }
    else
-      image->valeurs_pixel[numero_ligne][numero_colonne][0]=valeur[0];
+      pixel_PNM(image, numero_ligne, numero_colonne)[0]=valeur[0];
 }
 
 void changer_format(PNM *image, int format){
@@ -238,19 +757,18 @@ void changer_format(PNM *image, int format){
 void libere_PNM(PNM **image){
    if(*image!=NULL)//vérification de la validité du pointeur avant de le free
    {
-      for(int i=0; i<(*image)->nbr_ligne; i++){
-         for(int j=0; j<(*image)->nbr_colonne; j++)
-            free((*image)->valeurs_pixel[i][j]);
-         free((*image)->valeurs_pixel[i]);
+      if((*image)->valeurs_pixel!=NULL){
+         free((*image)->valeurs_pixel[0]);
+         free((*image)->valeurs_pixel);
       }
-      free((*image)->valeurs_pixel);
+      free((*image)->echantillons);//NULL pour une vue
       free(*image);
    }
    *image=NULL;
 }
 
 int lit_valeur_max(unsigned int *valeur_max, FILE  *fichier){
-   char contenu_fichier[100];
+   char contenu_fichier[100] = "";
    int nbr_fscanf = 0;
    do{
       if(contenu_fichier[0]!='#'){//vérifie que le premier caractère n'est pas un '#', si c'est le cas alors c'est un commentaire donc ignore la ligne
@@ -272,7 +790,7 @@ int lit_valeur_max(unsigned int *valeur_max, FILE  *fichier){
 
 int lit_dimensions_image(int *nbr_ligne, int *nbr_colonne, FILE *fichier){
    unsigned int n = 0;
-   char contenu_fichier[100];
+   char contenu_fichier[100] = "";
    int nbr_fscanf = 0; 
    do{
       if (contenu_fichier[0]=='#')//si premier caractère est un '#' alors la ligne est un commentaire
@@ -281,14 +799,14 @@ int lit_dimensions_image(int *nbr_ligne, int *nbr_colonne, FILE *fichier){
       nbr_fscanf = fscanf(fichier, "%s[^\n]", contenu_fichier);
       if (contenu_fichier[0]!='#'){
          n++;
-         if(n==1){
-            *nbr_ligne = atoi(contenu_fichier);
-            if (*nbr_ligne == 0)
+         if(n==1){//la largeur (nombre de colonnes) précède la hauteur dans l'en tête
+            *nbr_colonne = atoi(contenu_fichier);
+            if (*nbr_colonne == 0)
                return -1;
          }
          else if(n==2){
-            *nbr_colonne = atoi(contenu_fichier);
-            if (*nbr_colonne == 0)
+            *nbr_ligne = atoi(contenu_fichier);
+            if (*nbr_ligne == 0)
                return -1;
             return 0;
          }
@@ -301,7 +819,7 @@ int lit_dimensions_image(int *nbr_ligne, int *nbr_colonne, FILE *fichier){
 int verifie_nombre_magique(int *type, FILE*  fichier){
 
    unsigned int numero_ligne = 0;
-   char contenu_fichier[100];
+   char contenu_fichier[100] = "";
    int nbr_fscanf = 0;
 
    do{
@@ -342,6 +860,9 @@ int verifie_correspondance_extension_format(int type_image, char *filename, int
 
    while(filename[taille_nom]!='\0')
       taille_nom++;
+   //l'extension d'un fichier compressé précède ".gz"
+   if(est_compresse(filename))
+      taille_nom -= 3;
 
    //lis l'extension du fichier si on a la certitude que le nom de fichier a une taille suffisante pour que l'extension puisse exister
    if(taille_nom>4){
@@ -380,7 +901,7 @@ int write_pnm(PNM *image, char* filename) {
       printf("Impossible de copier l'image. Le nom contient des caractères interdits.\n");
       return -1;
    }
-   fichier = fopen(filename, "w");//ouvre le fichier d'écriture en mode "write"
+   fichier = ouvre_fichier_image(filename, "w");//ouvre le fichier d'écriture en mode "write"
    if (fichier==NULL){
       printf("Impossible d'ouvrir le fichier afin d'y copier l'image.\n");
       return -2;
@@ -388,33 +909,155 @@ int write_pnm(PNM *image, char* filename) {
    //écrit l'en tête du fichier 
    if(ecrit_en_tete_fichier_PNM(image, fichier)==-1){
       printf("Impossible d'écrire l'en tête.\n");
-      fclose(fichier);
+      ferme_fichier_image(fichier);
       return -2;
    }
    //écrit les valeurs de chaque pixel dans le fichier
    if(ecrit_image_dans_fichier(image, fichier)==-1){
       printf("Un problème est survenu lors de l'écriture de l'image.\n");
-      fclose(fichier);
+      ferme_fichier_image(fichier);
       return -2;
    }
    
-   fclose(fichier);
+   //pour un fichier compressé, la fermeture attend la fin de la compression
+   if(ferme_fichier_image(fichier)!=0){
+      printf("Un problème est survenu lors de l'écriture de l'image.\n");
+      return -2;
+   }
    
    return 0;
 }
 
 int ecrit_image_dans_fichier(PNM *image, FILE *fichier){
+   assert(image!=NULL && fichier!=NULL);
+   unsigned long nbr_valeurs = (unsigned long)image->nbr_ligne * image->nbr_colonne * (image->format==3 ? 3 : 1);
+
+   if(nbr_valeurs < SEUIL_ECRITURE_PARALLELE || nombre_threads_disponibles()==1 || image->nbr_ligne<2)
+      return ecrit_image_sequentiel(image, fichier);
+
+   return ecrit_image_parallele(image, fichier);
+}
+
+static int ecrit_image_sequentiel(PNM *image, FILE *fichier){
+    unsigned long long trace = debut_trace();
+
     for(int i=0; i<image->nbr_ligne; i++){
       for(int j=0; j<image->nbr_colonne; j++){
          if(image->format==3){
             for(int x=0; x<3; x++)
-               fprintf(fichier, "%hu ", image->valeurs_pixel[i][j][x]);
+               fprintf(fichier, "%hu ", pixel_PNM(image, i, j)[x]);
          }
          else
-            fprintf(fichier, "%hu ", image->valeurs_pixel[i][j][0]);
+            fprintf(fichier, "%hu ", pixel_PNM(image, i, j)[0]);
       }
       fprintf(fichier, "\n");
    }
+   fin_trace("ecriture_sequentielle", trace);
+   return 0;
+}
+
+static int ecrit_image_parallele(PNM *image, FILE *fichier){
+   Bande_ecriture bandes[NBR_MAX_THREADS];
+   pthread_t threads[NBR_MAX_THREADS];
+   struct iovec tampons[NBR_MAX_THREADS];
+   int lance[NBR_MAX_THREADS];
+   int nbr_bandes = nombre_threads_disponibles(), i, resultat = 0;
+
+   if(nbr_bandes > image->nbr_ligne)
+      nbr_bandes = image->nbr_ligne;
+
+   //chaque thread met en forme une bande de lignes dans son propre tampon
+   for(i=0; i<nbr_bandes; i++){
+      bandes[i].image = image;
+      bandes[i].premiere_ligne = (int)((long)image->nbr_ligne * i / nbr_bandes);
+      bandes[i].derniere_ligne = (int)((long)image->nbr_ligne * (i+1) / nbr_bandes);
+      bandes[i].texte = NULL;
+      bandes[i].taille = 0;
+      lance[i] = (pthread_create(&threads[i], NULL, met_en_forme_bande, &bandes[i])==0);
+      if(!lance[i])
+         met_en_forme_bande(&bandes[i]);
+   }
+   for(i=0; i<nbr_bandes; i++){
+      if(lance[i])
+         pthread_join(threads[i], NULL);
+      if(bandes[i].texte==NULL)
+         resultat = -1;
+      tampons[i].iov_base = bandes[i].texte;
+      tampons[i].iov_len = bandes[i].taille;
+   }
+
+   //les bandes sont écrites dans l'ordre, à la suite de l'en tête déjà bufferisé dans fichier
+   if(resultat==0 && fflush(fichier)==0)
+      resultat = ecrit_tampons(fileno(fichier), tampons, nbr_bandes);
+   else
+      resultat = -1;
+
+   for(i=0; i<nbr_bandes; i++)
+      free(bandes[i].texte);
+
+   return resultat;
+}
+
+static void *met_en_forme_bande(void *arg){
+   Bande_ecriture *bande = arg;
+   PNM *image = bande->image;
+   int nbr_canaux = (image->format==3) ? 3 : 1;
+   size_t taille_ligne = (size_t)image->nbr_colonne * nbr_canaux * 6 + 1;//au plus 5 chiffres et un espace par valeur
+   char *c, chiffres[5];
+   unsigned short valeur;
+   int n;
+   unsigned long long trace = debut_trace();
+
+   bande->texte = malloc(taille_ligne * (bande->derniere_ligne - bande->premiere_ligne));
+   if(bande->texte==NULL)
+      return NULL;
+
+   //équivalent de fprintf("%hu ") pour chaque valeur, suivi de "\n" en fin de ligne
+   c = bande->texte;
+   for(int i=bande->premiere_ligne; i<bande->derniere_ligne; i++){
+      for(int j=0; j<image->nbr_colonne; j++){
+         for(int x=0; x<nbr_canaux; x++){
+            valeur = pixel_PNM(image, i, j)[x];
+            n = 0;
+            do{
+               chiffres[n++] = '0' + valeur%10;
+               valeur /= 10;
+            }while(valeur>0);
+            while(n>0)
+               *c++ = chiffres[--n];
+            *c++ = ' ';
+         }
+      }
+      *c++ = '\n';
+   }
+   bande->taille = c - bande->texte;
+
+   fin_trace("mise_en_forme", trace);
+   return NULL;
+}
+
+static int ecrit_tampons(int descripteur, struct iovec *tampons, int nbr_tampons){
+   ssize_t ecrit;
+   unsigned long long trace = debut_trace();
+
+   while(nbr_tampons>0){
+      ecrit = writev(descripteur, tampons, nbr_tampons);
+      if(ecrit<0)
+         return -1;
+
+      //écriture partielle: reprise à partir du premier octet non écrit
+      while(nbr_tampons>0 && (size_t)ecrit >= tampons->iov_len){
+         ecrit -= tampons->iov_len;
+         tampons++;
+         nbr_tampons--;
+      }
+      if(nbr_tampons>0){
+         tampons->iov_base = (char *)tampons->iov_base + ecrit;
+         tampons->iov_len -= ecrit;
+      }
+   }
+
+   fin_trace("ecriture", trace);
    return 0;
 }
 
@@ -433,7 +1076,18 @@ int verifie_validite_filename(char *filename){
 
 int ecrit_en_tete_fichier_PNM(PNM *image, FILE *fichier){
    assert(image!=NULL && fichier!=NULL);
-   switch (image->format)
+   Entete_PNM entete;
+
+   entete.format = image->format;
+   entete.nbr_ligne = image->nbr_ligne;
+   entete.nbr_colonne = image->nbr_colonne;
+   entete.valeur_max = image->valeur_max;
+   return ecrit_en_tete_PNM(&entete, fichier);
+}
+
+int ecrit_en_tete_PNM(const Entete_PNM *entete, FILE *fichier){
+   assert(entete!=NULL && fichier!=NULL);
+   switch (entete->format)
    {
    case 1:
       fprintf(fichier, "P1\n");
@@ -448,10 +1102,10 @@ int ecrit_en_tete_fichier_PNM(PNM *image, FILE *fichier){
       return -1;
    }
 
-   fprintf(fichier, "%d %d\n", image->nbr_ligne, image->nbr_colonne);
+   fprintf(fichier, "%d %d\n", entete->nbr_colonne, entete->nbr_ligne);
 
-   if(image->format!=1)
-      fprintf(fichier, "%d\n", image->valeur_max);
+   if(entete->format!=1)
+      fprintf(fichier, "%u\n", entete->valeur_max);
 
    return 0;
 
@@ -459,9 +1113,15 @@ int ecrit_en_tete_fichier_PNM(PNM *image, FILE *fichier){
 
 int verifie_extension_fichier(char *filename, PNM *image){
    assert(filename!=NULL);
-   int format=acces_format_PNM(image);
+   return adapte_extension_format(filename, acces_format_PNM(image));
+}
+
+int adapte_extension_format(char *filename, int format){
+   assert(filename!=NULL);
 
    int taille=strlen(filename);
+   if(est_compresse(filename))
+      taille -= 3;
    if(taille>5){
       if(filename[taille-4]!='.'){
          printf("Extension du fichier %s incorrect.\n", filename);
@@ -17,13 +17,46 @@
  */
 typedef struct PNM_t PNM;
 
+/**
+ * Nombre maximal de threads utilisés par les traitements parallèles
+ */
+#define NBR_MAX_THREADS 64
+
+/**
+ * Attribut des noyaux de ligne dont les accès aux canaux sont entrelacés
+ * (pas de 3): sans permutation d'octets (SSE2 seul), gcc ne les vectorise
+ * pas. Sur x86-64, ces noyaux sont compilés en plusieurs versions et la
+ * meilleure pour le processeur est choisie au chargement du programme.
+ */
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(__clang__)
+#define NOYAU_VECTORIEL __attribute__((target_clones("avx2", "ssse3", "default")))
+#else
+#define NOYAU_VECTORIEL
+#endif
+
+/**
+ * \struct Entete_PNM
+ * \brief Informations contenues dans l'en tête d'un fichier PNM
+ *
+ */
+typedef struct {
+   int format;
+   int nbr_ligne, nbr_colonne;
+   unsigned int valeur_max;
+   long position_valeurs;//position (en octets) de la première valeur de pixel dans le fichier, -1 si inconnue
+   long taille_fichier;//taille du fichier en octets, -1 si inconnue (toujours pour un fichier compressé)
+} Entete_PNM;
+
 /**
  * \fn load_pnm(PNM **image, char* filename)
  * \brief Charge une image PNM depuis un fichier.
  * 
  * \param image l'adresse d'un pointeur sur PNM à laquelle écrire 
  * l'adresse de l'image chargée.
- * \param filename le chemin vers le fichier contenant l'image.
+ * \param filename le chemin vers le fichier contenant l'image, décompressé
+ * à la volée s'il se termine par ".gz" (par exemple image.ppm.gz). Un flux
+ * décompressé n'est pas positionnable: ses valeurs sont toujours analysées
+ * séquentiellement.
  * 
  * \pre image != NULL, filename != NULL
  * \post image pointe vers l'image chargée depuis le fichier.
@@ -37,6 +70,71 @@ typedef struct PNM_t PNM;
  */
 int load_pnm(PNM **image, char* filename);
 
+/**
+ * \fn *ouvre_fichier_PNM(char *filename, Entete_PNM *entete, int *erreur)
+ * \brief Ouvre un fichier PNM et lit son en tête, sans lire les valeurs de pixel.
+ * 
+ * \param filename le chemin vers le fichier contenant l'image.
+ * \param entete pointeur sur Entete_PNM recevant le format, les dimensions et la valeur max
+ * (position_valeurs et taille_fichier ne sont pas remplis)
+ * \param erreur pointeur sur int recevant le code d'erreur de load_pnm en cas d'échec
+ * 
+ * \pre filename != NULL, entete != NULL, erreur != NULL
+ * \post le fichier est positionné sur l'espacement qui précède la première valeur de pixel
+ * 
+ * \return
+ *     NULL en cas d'échec (voir *erreur) \n
+ *     le fichier ouvert sinon, à fermer avec ferme_fichier_image
+ *
+ */
+FILE *ouvre_fichier_PNM(char *filename, Entete_PNM *entete, int *erreur);
+
+/**
+ * \fn load_pnm_fenetre(PNM **image, char *filename, int x, int y, 
+ * int largeur, int hauteur)
+ * \brief Charge uniquement une fenêtre rectangulaire d'une image PNM.
+ * 
+ * La lecture du fichier s'arrête après la dernière ligne de la fenêtre.
+ * 
+ * \param image l'adresse d'un pointeur sur PNM à laquelle écrire 
+ * l'adresse de la fenêtre chargée.
+ * \param filename le chemin vers le fichier contenant l'image.
+ * \param x, y la colonne et la ligne du coin supérieur gauche de la fenêtre
+ * \param largeur, hauteur les dimensions de la fenêtre
+ * 
+ * \pre image != NULL, filename != NULL
+ * \post image pointe vers une image de largeur x hauteur pixels.
+ * 
+ * \return
+ *     0 Succès \n
+ *    -1 Erreur à l'allocation de mémoire \n
+ *    -2 Nom du fichier malformé \n
+ *    -3 Contenu du fichier malformé \n
+ *    -4 Fenêtre en dehors de l'image
+ *
+ */
+int load_pnm_fenetre(PNM **image, char *filename, int x, int y, int largeur, int hauteur);
+
+/**
+ * \fn lit_en_tete_PNM(Entete_PNM *entete, char *filename)
+ * \brief Lit uniquement l'en tête d'un fichier PNM, sans charger l'image.
+ * 
+ * \param entete pointeur sur Entete_PNM dans lequel écrire les informations lues
+ * \param filename le chemin vers le fichier contenant l'image.
+ * 
+ * \pre entete != NULL, filename != NULL
+ * \post entete contient le format, les dimensions, la valeur max, la position
+ * des valeurs de pixel et la taille du fichier. Pour un fichier compressé
+ * (".gz"), position_valeurs et taille_fichier valent -1: ils sont indisponibles.
+ * 
+ * \return
+ *     0 Succès \n
+ *    -2 Impossible d'ouvrir le fichier \n
+ *    -3 En tête du fichier malformé
+ *
+ */
+int lit_en_tete_PNM(Entete_PNM *entete, char *filename);
+
 /**
  * \fn *constructeur_PNM(int nbr_ligne, int nbr_colonne, int format, 
  * unsigned int valeur_max)
@@ -58,6 +156,91 @@ int load_pnm(PNM **image, char* filename);
  */
 PNM *constructeur_PNM(int nbr_ligne, int nbr_colonne, int format, unsigned int valeur_max);
 
+/**
+ * \fn *vue_PNM(PNM *image, int x, int y, int largeur, int hauteur)
+ * \brief Crée une vue sur un rectangle de image, sans copier ses valeurs.
+ * 
+ * La vue partage les valeurs de pixel de image: toute modification de la
+ * vue (par exemple par un filtre) modifie le rectangle correspondant de image.
+ * Seul le descripteur de la vue est alloué: ses lignes sont celles de image,
+ * à partir du pixel (y, x), avec le même pas.
+ * 
+ * \param image pointeur sur PNM, l'image à recadrer
+ * \param x, y la colonne et la ligne du coin supérieur gauche du rectangle
+ * \param largeur, hauteur les dimensions du rectangle
+ * 
+ * \pre image!=NULL
+ * \post image doit être libérée après la vue
+ * 
+ * \return
+ *      NULL si le rectangle dépasse de image ou en cas d'erreur d'allocation \n
+ *      un pointeur sur PNM, la vue sur le rectangle sinon
+ * 
+ */
+PNM *vue_PNM(PNM *image, int x, int y, int largeur, int hauteur);
+
+/**
+ * \fn harmonise_vue_PNM(PNM *vue, PNM *image)
+ * \brief Ramène les valeurs d'une vue au format de l'image dont elle est issue
+ * 
+ * Un filtre comme gris ou noir_blanc change le format de la vue à laquelle il
+ * est appliqué. Les valeurs de la vue sont alors recopiées sur toutes les
+ * composantes du format de image (un pixel noir PBM devient 0, un blanc valeur_max).
+ * 
+ * \param vue pointeur sur PNM, vue créée par vue_PNM sur image
+ * \param image pointeur sur PNM, l'image dont est issue la vue
+ * 
+ * \pre vue!=NULL, image!=NULL
+ * \post vue et image ont le même format
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Le format de la vue est supérieur à celui de image
+ * 
+ */
+int harmonise_vue_PNM(PNM *vue, PNM *image);
+
+/**
+ * \fn *copie_PNM(PNM *image)
+ * \brief Crée une copie indépendante de image (ou d'une vue), sans relire de fichier
+ * 
+ * Seules les composantes utiles du format de image sont copiées: une image
+ * PPM devenue grise donne une copie à une valeur par pixel.
+ * 
+ * \param image pointeur sur PNM, l'image à copier (seulement lue)
+ * 
+ * \pre image!=NULL
+ * \post /
+ * 
+ * \return
+ *      NULL en cas d'erreur d'allocation \n
+ *      un pointeur sur PNM, la copie sinon
+ * 
+ */
+PNM *copie_PNM(PNM *image);
+
+/**
+ * \fn reutilise_PNM(PNM *image, int nbr_ligne, int nbr_colonne, int format, unsigned int valeur_max)
+ * \brief Prépare le stockage de image à recevoir une nouvelle image, sans allocation
+ * 
+ * Possible si image a été créée par constructeur_PNM (ce n'est pas une vue),
+ * avec les mêmes dimensions et le même nombre de valeurs par pixel que le
+ * nouveau format, même si un filtre a changé entre temps son format.
+ * 
+ * \param image pointeur sur PNM, l'image dont le stockage est réutilisé
+ * \param nbr_ligne, nbr_colonne les dimensions de la nouvelle image
+ * \param format, valeur_max le format et la valeur max de la nouvelle image
+ * 
+ * \pre image!=NULL
+ * \post si le stockage est réutilisable, image a le format et la valeur max donnés
+ * 
+ * \return
+ *       0 Stockage réutilisé \n
+ *      -1 Stockage incompatible, une nouvelle image doit être construite
+ * 
+ */
+int reutilise_PNM(PNM *image, int nbr_ligne, int nbr_colonne, int format, unsigned int valeur_max);
+
 /**
  * \fn charge_valeurs_fichier(PNM *image, FILE *fichier)
  * \brief Charge les valeurs de pixel contenue dans fichier, dans image
@@ -65,6 +248,9 @@ PNM *constructeur_PNM(int nbr_ligne, int nbr_colonne, int format, unsigned int v
  * \param image pointeur sur PNM, l'image dans laquelle charger les valeurs de pixel
  * \param fichier pointeur sur FILE, le fichier contenant les valeurs à charger
  * 
+ * Les grands fichiers sont découpés en morceaux alignés sur des fins de ligne
+ * et analysés en parallèle.
+ * 
  * \pre:image!=NULL, fichier!=NULL
  * \post: valeur de fichier chargée dans le tableau image->valeurs_pixel
  * 
@@ -75,6 +261,51 @@ PNM *constructeur_PNM(int nbr_ligne, int nbr_colonne, int format, unsigned int v
  */
 int charge_valeurs_fichier(PNM *image, FILE *fichier);
 
+/**
+ * \fn charge_lignes_fichier(PNM *image, FILE *fichier)
+ * \brief Lit les image->nbr_ligne lignes suivantes de fichier
+ * 
+ * Les valeurs sont lues caractère par caractère: le fichier reste positionné
+ * juste après la dernière valeur lue, prêt pour les lignes suivantes. Les
+ * lignes du fichier doivent avoir la largeur de image.
+ * 
+ * \param image pointeur sur PNM (éventuellement une vue) recevant les valeurs
+ * \param fichier pointeur sur FILE, positionné au début d'une ligne de l'image
+ * 
+ * \pre:image!=NULL, fichier!=NULL
+ * \post: image contient les lignes lues
+ * 
+ * \return
+ *       0 Succès du chargement \n
+ *      -1 valeur de fichier incorrect ou manquante
+ * 
+ */
+int charge_lignes_fichier(PNM *image, FILE *fichier);
+
+/**
+ * \fn indexe_lignes_PNM(char *filename, const Entete_PNM *entete, int pas, long *positions)
+ * \brief Relève la position dans filename de la première valeur de chaque bande de pas lignes
+ * 
+ * Le fichier est projeté en mémoire (mmap) et parcouru une seule fois sans
+ * analyser les valeurs: chaque bande peut ensuite être relue directement,
+ * dans n'importe quel ordre, par fseek puis charge_lignes_fichier. Un
+ * fichier compressé ne peut être indexé.
+ * 
+ * \param filename le fichier image, non compressé
+ * \param entete l'en tête de filename, lu par lit_en_tete_PNM
+ * \param pas le nombre de lignes par bande
+ * \param positions tableau recevant les (nbr_ligne + pas - 1) / pas positions, en octets
+ * 
+ * \pre:filename!=NULL, entete!=NULL, pas>=1, positions!=NULL
+ * \post: positions[b] est la position de la ligne b*pas
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Fichier compressé, illisible ou trop court
+ * 
+ */
+int indexe_lignes_PNM(char *filename, const Entete_PNM *entete, int pas, long *positions);
+
 /**
  * \fn acces_nbr_ligne_PNM(PNM *image)
  * \brief accesseur à la valeur du nombre de ligne de image
@@ -139,17 +370,60 @@ unsigned int acces_valeur_max_PNM(PNM *image);
  * \fn ***acces_valeurs_pixel_PNM(PNM *image)
  * \brief accesseur au tableau de pixels de image
  * 
+ * Le tableau (un pointeur par pixel) n'est construit qu'au premier appel,
+ * puis conservé jusqu'à libere_PNM. Les fonctions du module n'en ont pas
+ * besoin: préférer acces_ligne_PNM, qui n'alloue rien.
+ * 
  * \param image pointeur sur PNM
  * 
  * \pre: image!=NULL
  * \post:/
  * 
  * return:
- *      image->valeurs_pixel
+ *      NULL en cas d'erreur d'allocation \n
+ *      image->valeurs_pixel sinon
  * 
  */
 unsigned short ***acces_valeurs_pixel_PNM(PNM *image);
 
+/**
+ * \fn acces_nbr_canaux_PNM(PNM *image)
+ * \brief accesseur au nombre de valeurs stockées pour chaque pixel de image
+ * 
+ * Ce nombre est fixé à la construction (3 pour une image PPM, 1 sinon) et ne
+ * change pas avec le format: après un filtre gris, la valeur grise est
+ * stockée dans la première des 3 valeurs de chaque pixel.
+ * 
+ * \param image pointeur sur PNM
+ * 
+ * \pre: image!=NULL
+ * \post:/
+ * 
+ * return:
+ *      image->nbr_canaux
+ * 
+ */
+int acces_nbr_canaux_PNM(PNM *image);
+
+/**
+ * \fn *acces_ligne_PNM(PNM *image, int numero_ligne)
+ * \brief accesseur aux valeurs d'une ligne de image
+ * 
+ * Les valeurs d'une ligne sont contiguës: la composante x du pixel j se
+ * trouve à l'indice j*acces_nbr_canaux_PNM(image)+x.
+ * 
+ * \param image pointeur sur PNM
+ * \param numero_ligne entier contenant le numéro de la ligne
+ * 
+ * \pre: image!=NULL, 0<=numero_ligne<nbr_ligne
+ * \post:/
+ * 
+ * return:
+ *      un pointeur sur la première valeur de la ligne
+ * 
+ */
+unsigned short *acces_ligne_PNM(PNM *image, int numero_ligne);
+
 /**
  * \fn changer_valeur_pixel_PNM(PNM *image, int numero_ligne, 
  * int numero_colonne, unsigned short valeur[])
@@ -188,6 +462,9 @@ void changer_format(PNM *image, int format);
  * 
  * \param image l'adresse d'un pointeur sur PNM à libérer
  * 
+ * Pour une vue, seules les tables de pointeurs sont libérées, les valeurs
+ * appartenant à l'image dont elle est issue.
+ * 
  * \pre image != NULL
  * \post image == NULL
  * 
@@ -211,7 +488,7 @@ int lit_valeur_max(unsigned int *valeur_max, FILE  *fichier);
  * \fn lit_dimensions_image(int *nbr_ligne, int *nbr_colonne, 
  * FILE *fichier)
  * \brief Enregistre dans la variable dimension, les dimensions de 
- * l'image contenues dans fichier
+ * l'image contenues dans fichier (la largeur précède la hauteur)
  * 
  * \param Dimension_pixel un pointeur sur Dimension_pixel auquel 
  * écrire les dimensions de l'image PNM
@@ -249,7 +526,8 @@ int verifie_nombre_magique(int *type, FILE*  fichier);
  * char *filename, int *extension_fichier)
  * 
  * \brief Vérifie si l'extension du fichier dans le nom de celui-ci 
- * correspond au type de type_image déduit du nombre magique
+ * correspond au type de type_image déduit du nombre magique.
+ * Le suffixe ".gz" d'un fichier compressé est ignoré.
  * 
  * \param type_image entier contenant le format de l'image
  * \param filename une chaine de caractère contenant le nom du fichier
@@ -267,7 +545,8 @@ int verifie_correspondance_extension_format(int type_image, char *filename, int
  * \brief Sauvegarde une image PNM dans un fichier.
  *
  * \param image un pointeur sur PNM.
- * \param filename le chemin vers le fichier de destination.
+ * \param filename le chemin vers le fichier de destination, compressé
+ * à la volée s'il se termine par ".gz".
  *
  * \pre: image != NULL, filename != NULL
  * \post: le fichier filename contient l'image PNM image.
@@ -290,11 +569,15 @@ int write_pnm(PNM *image, char* filename);
  * \param fichier un pointeur sur FILE, un fichier ouvert en 
  * mode "write" afin d'y retranscrire une image PNM
  * 
+ * Les grandes images sont mises en forme par bandes de lignes en parallèle,
+ * puis écrites dans l'ordre avec writev.
+ * 
  * \pre:/
  * \post:/
  * 
  * \return
- *   0  succès de l'écriture du fichier
+ *   0  succès de l'écriture du fichier \n
+ *  -1  échec de l'allocation des tampons ou de l'écriture
  * 
  */
 int ecrit_image_dans_fichier(PNM *image, FILE *fichier);
@@ -319,6 +602,24 @@ int ecrit_image_dans_fichier(PNM *image, FILE *fichier);
  */
 int ecrit_en_tete_fichier_PNM(PNM *image, FILE *fichier);
 
+/**
+ * \fn ecrit_en_tete_PNM(const Entete_PNM *entete, FILE *fichier)
+ * \brief écrit l'en tête décrit par entete, par exemple celui d'une 
+ * image écrite bande par bande
+ * 
+ * \param entete pointeur sur Entete_PNM (format, dimensions, valeur max)
+ * \param fichier pointeur sur FILE un fichier ouvert en mode "write"
+ * 
+ * \pre:entete!=NULL, fichier!=NULL
+ * \post:/
+ * 
+ * \return
+ *       0  succès de l'écriture de l'en tête dans fichier \n
+ *      -1  format incorrect
+ * 
+ */
+int ecrit_en_tete_PNM(const Entete_PNM *entete, FILE *fichier);
+
 /**
  * \fn verifie_validite_filename(char *filename)
  * \brief Vérifie si le nom du fichier d'écriture ne contient pas 
@@ -355,5 +656,32 @@ int verifie_validite_filename(char *filename);
  */
 int verifie_extension_fichier(char *filename, PNM *image);
 
+/**
+ * \fn adapte_extension_format(char *filename, int format)
+ * \brief vérifie l'existence de l'extension de filename et la remplace
+ * par celle du format donné (pbm, pgm ou ppm).
+ * 
+ * \param filename chaine de caractères contenant le nom de l'image_output
+ * \param format le format (1, 2 ou 3) auquel l'extension doit correspondre
+ * 
+ * \pre: filename!=NULL
+ * \post: extension de filename correspond à format
+ * 
+ * \return 
+ *       0 Succès de la vérification \n
+ *      -1 Extension incorrect/inexistante
+ * 
+ */
+int adapte_extension_format(char *filename, int format);
+
+/**
+ * \fn nombre_threads_disponibles(void)
+ * \brief Donne le nombre de threads à utiliser pour les traitements parallèles
+ * 
+ * \return
+ *      le nombre de processeurs en ligne, borné entre 1 et NBR_MAX_THREADS
+ */
+int nombre_threads_disponibles(void);
+
 #endif // __PNM__
 
@@ -0,0 +1,447 @@
+/**
+ * \file quantification.c
+ * \brief Ce fichier contient la réduction de palette des images PPM (coupe médiane, k-moyennes).
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "quantification.h"
+#include "ordonnanceur.h"
+#include "filtre.h"
+#include "pnm.h"
+
+/**
+ * Nombre de niveaux par composante et nombre de cases du cube de couleurs
+ */
+#define NIVEAUX_CUBE (1 << BITS_CUBE_QUANTIFICATION)
+#define NBR_CASES_CUBE (NIVEAUX_CUBE * NIVEAUX_CUBE * NIVEAUX_CUBE)
+
+/**
+ * \struct Boite
+ * \brief Parallélépipède [min, max] de niveaux du cube, réduit aux cases occupées
+ */
+typedef struct {
+    int min[3], max[3];
+    unsigned long long nbr_pixels;
+} Boite;
+
+/**
+ * \struct Quantification
+ * \brief Cube de couleurs, palette et table inverse partagés par les tâches
+ */
+typedef struct {
+    PNM *image;
+    int nbr_canaux;
+    unsigned int valeur_max;
+    unsigned char *niveaux;//par valeur d'une composante, son niveau dans le cube
+    double centres[NIVEAUX_CUBE];//valeur au centre de chaque niveau
+    int nbr_bandes;
+    unsigned int *histogrammes;//un cube par bande de lignes, additionnés dans le premier
+    int nbr_couleurs;
+    double couleurs[NBR_MAX_COULEURS][3];
+    unsigned short palette[NBR_MAX_COULEURS][3];//couleurs arrondies, écrites dans l'image
+    unsigned char *table_inverse;//par case, indice de la couleur la plus proche de son centre
+} Quantification;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static void histogramme_bande(int indice, void *contexte);
+static void coupe_mediane(Quantification *quantification, int nbr_couleurs);
+static void reduit_boite(const Quantification *quantification, Boite *boite);
+static void moyenne_boite(Quantification *quantification, const Boite *boite, double *couleur);
+static int kmoyennes(Quantification *quantification);
+static void table_inverse_tranche(int indice, void *contexte);
+static void remplace_tuile(const Tuile *tuile, void *contexte);
+static int diffuse_erreur(Quantification *quantification);
+static inline int case_cube(const Quantification *quantification, const unsigned short *pixel);
+static inline double distance_couleur(const double *a, const double *b);
+
+
+int quantification(PNM *image, int nbr_couleurs, Methode_quantification methode, Tramage tramage){
+    assert(image!=NULL && nbr_couleurs>=2 && nbr_couleurs<=NBR_MAX_COULEURS);
+    Quantification quantification;
+    int nbr_ligne = acces_nbr_ligne_PNM(image), resultat = 0;
+
+    if(acces_format_PNM(image)!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour en réduire la palette.\n");
+        return -1;
+    }
+    if(nbr_ligne==0 || acces_nbr_colonne_PNM(image)==0)
+        return 0;
+
+    memset(&quantification, 0, sizeof(Quantification));
+    quantification.image = image;
+    quantification.nbr_canaux = acces_nbr_canaux_PNM(image);
+    quantification.valeur_max = acces_valeur_max_PNM(image);
+    quantification.nbr_bandes = nombre_threads_disponibles();
+    if(quantification.nbr_bandes > nbr_ligne)
+        quantification.nbr_bandes = nbr_ligne;
+    if(quantification.nbr_bandes < 1)
+        quantification.nbr_bandes = 1;
+
+    quantification.niveaux = malloc(quantification.valeur_max + 1);
+    quantification.histogrammes = malloc((size_t)quantification.nbr_bandes * NBR_CASES_CUBE * sizeof(unsigned int));
+    quantification.table_inverse = malloc(NBR_CASES_CUBE);
+    if(quantification.niveaux==NULL || quantification.histogrammes==NULL || quantification.table_inverse==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        free(quantification.niveaux);
+        free(quantification.histogrammes);
+        free(quantification.table_inverse);
+        return -2;
+    }
+
+    //les valeurs [0, valeur_max] sont réparties également entre les niveaux
+    for(unsigned int v=0; v<=quantification.valeur_max; v++)
+        quantification.niveaux[v] = (unsigned char)((unsigned long)v * NIVEAUX_CUBE / (quantification.valeur_max + 1));
+    for(int n=0; n<NIVEAUX_CUBE; n++){
+        quantification.centres[n] = (n + 0.5) * (quantification.valeur_max + 1) / NIVEAUX_CUBE - 0.5;
+        if(quantification.centres[n] < 0)
+            quantification.centres[n] = 0;
+    }
+
+    //un cube par bande, additionnés ensuite dans le premier
+    execute_taches(quantification.nbr_bandes, histogramme_bande, &quantification);
+    for(int b=1; b<quantification.nbr_bandes; b++){
+        for(int k=0; k<NBR_CASES_CUBE; k++)
+            quantification.histogrammes[k] += quantification.histogrammes[(size_t)b*NBR_CASES_CUBE + k];
+    }
+
+    coupe_mediane(&quantification, nbr_couleurs);
+    if(methode==quantification_kmoyennes && kmoyennes(&quantification)!=0)
+        resultat = -2;
+
+    if(resultat==0){
+        for(int c=0; c<quantification.nbr_couleurs; c++){
+            for(int x=0; x<3; x++){
+                quantification.palette[c][x] = (unsigned short)(quantification.couleurs[c][x] + 0.5);
+                if(quantification.palette[c][x] > quantification.valeur_max)
+                    quantification.palette[c][x] = (unsigned short)quantification.valeur_max;
+            }
+        }
+
+        //table inverse, une tâche par niveau de rouge; puis une consultation par pixel
+        execute_taches(NIVEAUX_CUBE, table_inverse_tranche, &quantification);
+        if(tramage==tramage_floyd_steinberg)
+            resultat = diffuse_erreur(&quantification);
+        else
+            execute_tuiles(nbr_ligne, acces_nbr_colonne_PNM(image), quantification.nbr_canaux * sizeof(unsigned short),
+                           remplace_tuile, &quantification);
+    }
+
+    free(quantification.niveaux);
+    free(quantification.histogrammes);
+    free(quantification.table_inverse);
+
+    return resultat;
+}
+
+static void histogramme_bande(int indice, void *contexte){
+    Quantification *quantification = contexte;
+    int nbr_ligne = acces_nbr_ligne_PNM(quantification->image), nbr_colonne = acces_nbr_colonne_PNM(quantification->image);
+    int nbr_canaux = quantification->nbr_canaux;
+    int debut = (int)((long)nbr_ligne * indice / quantification->nbr_bandes);
+    int fin = (int)((long)nbr_ligne * (indice+1) / quantification->nbr_bandes);
+    unsigned int *histogramme = quantification->histogrammes + (size_t)indice * NBR_CASES_CUBE;
+    unsigned short *ligne;
+
+    memset(histogramme, 0, NBR_CASES_CUBE * sizeof(unsigned int));
+    for(int i=debut; i<fin; i++){
+        ligne = acces_ligne_PNM(quantification->image, i);
+        for(int j=0; j<nbr_colonne; j++)
+            histogramme[case_cube(quantification, &ligne[j*nbr_canaux])]++;
+    }
+}
+
+static void coupe_mediane(Quantification *quantification, int nbr_couleurs){
+    Boite boites[NBR_MAX_COULEURS];
+    unsigned long long projection[NIVEAUX_CUBE], cumul;
+    const unsigned int *histogramme = quantification->histogrammes;
+    int nbr_boites = 1, choisie, axe, cote, coupe, niveau[3];
+    double score, meilleur;
+
+    for(int x=0; x<3; x++){
+        boites[0].min[x] = 0;
+        boites[0].max[x] = NIVEAUX_CUBE-1;
+    }
+    reduit_boite(quantification, &boites[0]);
+
+    while(nbr_boites < nbr_couleurs){
+        //boîte la plus peuplée, pondérée par son plus grand côté; une boîte d'une seule case ne se partage plus
+        choisie = -1;
+        meilleur = 0;
+        for(int b=0; b<nbr_boites; b++){
+            cote = 0;
+            for(int x=0; x<3; x++){
+                if(boites[b].max[x] - boites[b].min[x] > cote)
+                    cote = boites[b].max[x] - boites[b].min[x];
+            }
+            score = (double)boites[b].nbr_pixels * cote;
+            if(score > meilleur){
+                meilleur = score;
+                choisie = b;
+            }
+        }
+        if(choisie<0)
+            break;
+
+        axe = 0;
+        for(int x=1; x<3; x++){
+            if(boites[choisie].max[x] - boites[choisie].min[x] > boites[choisie].max[axe] - boites[choisie].min[axe])
+                axe = x;
+        }
+
+        //population de chaque niveau de la boîte le long de l'axe, puis niveau médian
+        memset(projection, 0, sizeof(projection));
+        for(niveau[0]=boites[choisie].min[0]; niveau[0]<=boites[choisie].max[0]; niveau[0]++){
+            for(niveau[1]=boites[choisie].min[1]; niveau[1]<=boites[choisie].max[1]; niveau[1]++){
+                for(niveau[2]=boites[choisie].min[2]; niveau[2]<=boites[choisie].max[2]; niveau[2]++)
+                    projection[niveau[axe]] += histogramme[(niveau[0] << (2*BITS_CUBE_QUANTIFICATION))
+                                                           | (niveau[1] << BITS_CUBE_QUANTIFICATION) | niveau[2]];
+            }
+        }
+        cumul = 0;
+        for(coupe=boites[choisie].min[axe]; coupe<boites[choisie].max[axe]-1; coupe++){
+            cumul += projection[coupe];
+            if(2*cumul >= boites[choisie].nbr_pixels)
+                break;
+        }
+
+        boites[nbr_boites] = boites[choisie];
+        boites[choisie].max[axe] = coupe;
+        boites[nbr_boites].min[axe] = coupe + 1;
+        reduit_boite(quantification, &boites[choisie]);
+        reduit_boite(quantification, &boites[nbr_boites]);
+        nbr_boites++;
+    }
+
+    quantification->nbr_couleurs = nbr_boites;
+    for(int b=0; b<nbr_boites; b++)
+        moyenne_boite(quantification, &boites[b], quantification->couleurs[b]);
+}
+
+static void reduit_boite(const Quantification *quantification, Boite *boite){
+    const unsigned int *histogramme = quantification->histogrammes;
+    int min[3] = {NIVEAUX_CUBE, NIVEAUX_CUBE, NIVEAUX_CUBE}, max[3] = {-1, -1, -1}, niveau[3];
+    unsigned int nbr;
+
+    boite->nbr_pixels = 0;
+    for(niveau[0]=boite->min[0]; niveau[0]<=boite->max[0]; niveau[0]++){
+        for(niveau[1]=boite->min[1]; niveau[1]<=boite->max[1]; niveau[1]++){
+            for(niveau[2]=boite->min[2]; niveau[2]<=boite->max[2]; niveau[2]++){
+                nbr = histogramme[(niveau[0] << (2*BITS_CUBE_QUANTIFICATION)) | (niveau[1] << BITS_CUBE_QUANTIFICATION) | niveau[2]];
+                if(nbr==0)
+                    continue;
+                boite->nbr_pixels += nbr;
+                for(int x=0; x<3; x++){
+                    if(niveau[x] < min[x])
+                        min[x] = niveau[x];
+                    if(niveau[x] > max[x])
+                        max[x] = niveau[x];
+                }
+            }
+        }
+    }
+
+    //une boîte vide garde ses limites: elle n'est jamais choisie (population nulle)
+    if(boite->nbr_pixels>0){
+        memcpy(boite->min, min, sizeof(min));
+        memcpy(boite->max, max, sizeof(max));
+    }
+}
+
+static void moyenne_boite(Quantification *quantification, const Boite *boite, double *couleur){
+    const unsigned int *histogramme = quantification->histogrammes;
+    double somme[3] = {0, 0, 0};
+    int niveau[3];
+    unsigned int nbr;
+
+    for(niveau[0]=boite->min[0]; niveau[0]<=boite->max[0]; niveau[0]++){
+        for(niveau[1]=boite->min[1]; niveau[1]<=boite->max[1]; niveau[1]++){
+            for(niveau[2]=boite->min[2]; niveau[2]<=boite->max[2]; niveau[2]++){
+                nbr = histogramme[(niveau[0] << (2*BITS_CUBE_QUANTIFICATION)) | (niveau[1] << BITS_CUBE_QUANTIFICATION) | niveau[2]];
+                for(int x=0; x<3; x++)
+                    somme[x] += (double)nbr * quantification->centres[niveau[x]];
+            }
+        }
+    }
+
+    for(int x=0; x<3; x++)
+        couleur[x] = (boite->nbr_pixels>0) ? somme[x] / boite->nbr_pixels : quantification->centres[boite->min[x]];
+}
+
+static int kmoyennes(Quantification *quantification){
+    const unsigned int *histogramme = quantification->histogrammes;
+    int nbr_occupees = 0, nbr_couleurs = quantification->nbr_couleurs, plus_proche, change = 1;
+    int *cases, *groupes;
+    double centre[3], distance, minimum, sommes[NBR_MAX_COULEURS][3], poids[NBR_MAX_COULEURS];
+
+    for(int k=0; k<NBR_CASES_CUBE; k++)
+        nbr_occupees += (histogramme[k]!=0);
+    cases = malloc(nbr_occupees * sizeof(int));
+    groupes = malloc(nbr_occupees * sizeof(int));
+    if(cases==NULL || groupes==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        free(cases);
+        free(groupes);
+        return -2;
+    }
+    nbr_occupees = 0;
+    for(int k=0; k<NBR_CASES_CUBE; k++){
+        if(histogramme[k]!=0){
+            cases[nbr_occupees] = k;
+            groupes[nbr_occupees++] = -1;
+        }
+    }
+
+    //itérations de Lloyd sur les cases occupées, pondérées par leur population
+    for(int iteration=0; iteration<NBR_ITERATIONS_KMOYENNES && change; iteration++){
+        change = 0;
+        memset(sommes, 0, sizeof(sommes));
+        memset(poids, 0, sizeof(poids));
+        for(int o=0; o<nbr_occupees; o++){
+            centre[0] = quantification->centres[cases[o] >> (2*BITS_CUBE_QUANTIFICATION)];
+            centre[1] = quantification->centres[(cases[o] >> BITS_CUBE_QUANTIFICATION) & (NIVEAUX_CUBE-1)];
+            centre[2] = quantification->centres[cases[o] & (NIVEAUX_CUBE-1)];
+            plus_proche = 0;
+            minimum = distance_couleur(centre, quantification->couleurs[0]);
+            for(int c=1; c<nbr_couleurs; c++){
+                distance = distance_couleur(centre, quantification->couleurs[c]);
+                if(distance < minimum){
+                    minimum = distance;
+                    plus_proche = c;
+                }
+            }
+            if(groupes[o]!=plus_proche){
+                groupes[o] = plus_proche;
+                change = 1;
+            }
+            for(int x=0; x<3; x++)
+                sommes[plus_proche][x] += (double)histogramme[cases[o]] * centre[x];
+            poids[plus_proche] += histogramme[cases[o]];
+        }
+
+        //une couleur sans case garde sa valeur
+        for(int c=0; c<nbr_couleurs; c++){
+            if(poids[c]>0){
+                for(int x=0; x<3; x++)
+                    quantification->couleurs[c][x] = sommes[c][x] / poids[c];
+            }
+        }
+    }
+
+    free(cases);
+    free(groupes);
+    return 0;
+}
+
+static void table_inverse_tranche(int indice, void *contexte){
+    Quantification *quantification = contexte;
+    double centre[3], couleur[3], distance, minimum;
+    int plus_proche;
+
+    centre[0] = quantification->centres[indice];
+    for(int v=0; v<NIVEAUX_CUBE; v++){
+        centre[1] = quantification->centres[v];
+        for(int b=0; b<NIVEAUX_CUBE; b++){
+            centre[2] = quantification->centres[b];
+            plus_proche = 0;
+            minimum = -1;
+            for(int c=0; c<quantification->nbr_couleurs; c++){
+                for(int x=0; x<3; x++)
+                    couleur[x] = quantification->palette[c][x];
+                distance = distance_couleur(centre, couleur);
+                if(minimum<0 || distance < minimum){
+                    minimum = distance;
+                    plus_proche = c;
+                }
+            }
+            quantification->table_inverse[(indice << (2*BITS_CUBE_QUANTIFICATION)) | (v << BITS_CUBE_QUANTIFICATION) | b]
+                = (unsigned char)plus_proche;
+        }
+    }
+}
+
+static void remplace_tuile(const Tuile *tuile, void *contexte){
+    Quantification *quantification = contexte;
+    int nbr_canaux = quantification->nbr_canaux;
+    const unsigned short *couleur;
+    unsigned short *ligne, *pixel;
+
+    for(int i=tuile->y; i<tuile->y+tuile->hauteur; i++){
+        ligne = acces_ligne_PNM(quantification->image, i);
+        for(int j=tuile->x; j<tuile->x+tuile->largeur; j++){
+            pixel = &ligne[j*nbr_canaux];
+            couleur = quantification->palette[quantification->table_inverse[case_cube(quantification, pixel)]];
+            pixel[0] = couleur[0];
+            pixel[1] = couleur[1];
+            pixel[2] = couleur[2];
+        }
+    }
+}
+
+static int diffuse_erreur(Quantification *quantification){
+    PNM *image = quantification->image;
+    int nbr_ligne = acces_nbr_ligne_PNM(image), nbr_colonne = acces_nbr_colonne_PNM(image), nbr_canaux = quantification->nbr_canaux;
+    long largeur = 3L * (nbr_colonne + 2), valeur, ecart;
+    long *erreurs, *courante, *suivante;
+    unsigned short *ligne, *pixel, corrige[3];
+    const unsigned short *couleur;
+
+    //erreurs en seizièmes de la ligne courante et de la suivante, une colonne de marge de chaque côté
+    erreurs = calloc(2 * largeur, sizeof(long));
+    if(erreurs==NULL){
+        printf("Allocation de mémoire impossible.\n");
+        return -2;
+    }
+
+    for(int i=0; i<nbr_ligne; i++){
+        courante = erreurs + (i % 2) * largeur + 3;
+        suivante = erreurs + ((i + 1) % 2) * largeur + 3;
+        memset(suivante - 3, 0, largeur * sizeof(long));
+        ligne = acces_ligne_PNM(image, i);
+
+        for(int j=0; j<nbr_colonne; j++){
+            pixel = &ligne[j*nbr_canaux];
+            for(int x=0; x<3; x++){
+                valeur = pixel[x] + courante[3*j+x] / 16;
+                if(valeur < 0)
+                    valeur = 0;
+                if(valeur > (long)quantification->valeur_max)
+                    valeur = quantification->valeur_max;
+                corrige[x] = (unsigned short)valeur;
+            }
+
+            couleur = quantification->palette[quantification->table_inverse[case_cube(quantification, corrige)]];
+            for(int x=0; x<3; x++){
+                ecart = (long)corrige[x] - couleur[x];
+                courante[3*(j+1)+x] += 7 * ecart;
+                suivante[3*(j-1)+x] += 3 * ecart;
+                suivante[3*j+x] += 5 * ecart;
+                suivante[3*(j+1)+x] += ecart;
+                pixel[x] = couleur[x];
+            }
+        }
+    }
+
+    free(erreurs);
+    return 0;
+}
+
+static inline int case_cube(const Quantification *quantification, const unsigned short *pixel){
+    const unsigned char *niveaux = quantification->niveaux;
+
+    return (niveaux[pixel[0]] << (2*BITS_CUBE_QUANTIFICATION)) | (niveaux[pixel[1]] << BITS_CUBE_QUANTIFICATION) | niveaux[pixel[2]];
+}
+
+static inline double distance_couleur(const double *a, const double *b){
+    return (a[0]-b[0])*(a[0]-b[0]) + (a[1]-b[1])*(a[1]-b[1]) + (a[2]-b[2])*(a[2]-b[2]);
+}
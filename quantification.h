@@ -0,0 +1,77 @@
+/**
+ * \file quantification.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes de la réduction de palette des images PPM.
+ *
+ * Les couleurs de l'image sont comptées dans un cube de 32 x 32 x 32 cases
+ * (5 bits par composante), en parallèle par bandes de lignes. La palette est
+ * choisie sur ce cube, par coupe médiane ou par k-moyennes, puis une table
+ * inverse donne pour chaque case l'indice de la couleur de la palette la
+ * plus proche: chaque pixel est ensuite remplacé en une seule consultation
+ * de la table, sans recherche parmi les couleurs de la palette.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __QUANTIFICATION__
+#define __QUANTIFICATION__
+
+#include "pnm.h"
+#include "filtre.h"
+
+/**
+ * Nombre de bits par composante du cube de couleurs
+ */
+#define BITS_CUBE_QUANTIFICATION 5
+
+/**
+ * Nombre maximal de couleurs de la palette
+ */
+#define NBR_MAX_COULEURS 256
+
+/**
+ * Nombre maximal d'itérations des k-moyennes
+ */
+#define NBR_ITERATIONS_KMOYENNES 16
+
+/**
+ * \enum typedef enum Methode_quantification
+ * \brief Choix de la palette
+ *
+ */
+typedef enum {
+    quantification_coupe_mediane,//coupe médiane (Heckbert)
+    quantification_kmoyennes//k-moyennes initialisées par la coupe médiane
+} Methode_quantification;
+
+/**
+ * \fn quantification(PNM *image, int nbr_couleurs, Methode_quantification methode, Tramage tramage)
+ * \brief Réduit une image PPM à au plus nbr_couleurs couleurs
+ *
+ * La coupe médiane partage récursivement la boîte de couleurs qui contient
+ * le plus de pixels (pondérés par son plus grand côté) en deux boîtes de
+ * même population, le long de son plus grand côté. Les k-moyennes
+ * affinent ensuite cette palette sur les cases occupées du cube. Avec
+ * tramage_floyd_steinberg, l'erreur de chaque pixel est diffusée à ses
+ * voisins (parcours séquentiel); sans tramage, les pixels sont remplacés en
+ * parallèle.
+ *
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * \param nbr_couleurs le nombre maximal de couleurs, entre 2 et NBR_MAX_COULEURS
+ * \param methode le choix de la palette
+ * \param tramage tramage_aucun ou tramage_floyd_steinberg
+ *
+ * \pre image!=NULL, 2<=nbr_couleurs<=NBR_MAX_COULEURS
+ * \post valeurs du tableau de pixel modifiées
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Format d'image différent de ppm \n
+ *      -2 Erreur d'allocation de mémoire
+ *
+ */
+int quantification(PNM *image, int nbr_couleurs, Methode_quantification methode, Tramage tramage);
+
+#endif
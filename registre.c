@@ -0,0 +1,646 @@
+/**
+ * \file registre.c
+ * \brief Ce fichier contient le registre des filtres applicables à des images PNM.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+#include "registre.h"
+#include "filtre.h"
+#include "couleur.h"
+#include "integrale.h"
+#include "median.h"
+#include "morphologie.h"
+#include "egalisation.h"
+#include "quantification.h"
+#include "bilateral.h"
+#include "trace.h"
+#include "pnm.h"
+
+/**
+ * Déclaration des fonctions statiques de lecture, validation et application
+ * des paramètres de chaque filtre
+ * 
+ */
+static int lit_entier(const char *texte, long min, long max, long *valeur);
+static int lit_couleur(const char *texte, Parametre_filtre *parametre);
+static int lit_technique(const char *texte, Parametre_filtre *parametre);
+static int lit_seuil(const char *texte, Parametre_filtre *parametre);
+static int lit_matrice(const char *texte, Parametre_filtre *parametre);
+static int lit_teinte(const char *texte, Parametre_filtre *parametre);
+static int lit_rayon_reel(const char *texte, double defaut, Parametre_filtre *parametre);
+static int lit_rayon(const char *texte, Parametre_filtre *parametre);
+static int lit_rayon_sauvola(const char *texte, Parametre_filtre *parametre);
+static int lit_rayon_bradley(const char *texte, Parametre_filtre *parametre);
+static int lit_rayon_median(const char *texte, Parametre_filtre *parametre);
+static int lit_element_structurant(const char *texte, Parametre_filtre *parametre);
+static int lit_clahe(const char *texte, Parametre_filtre *parametre);
+static int lit_quantification(const char *texte, Parametre_filtre *parametre);
+static int lit_bilateral(const char *texte, Parametre_filtre *parametre);
+static int valide_pbm(const Parametre_filtre *parametre, PNM *image);
+static int valide_gris(const Parametre_filtre *parametre, PNM *image);
+static int valide_ppm(const Parametre_filtre *parametre, PNM *image);
+static int valide_seuil(const Parametre_filtre *parametre, PNM *image);
+static int applique_retournement(PNM *image, const Parametre_filtre *parametre);
+static int applique_miroir_horizontal(PNM *image, const Parametre_filtre *parametre);
+static int applique_miroir_vertical(PNM *image, const Parametre_filtre *parametre);
+static int applique_monochrome(PNM *image, const Parametre_filtre *parametre);
+static int applique_negatif(PNM *image, const Parametre_filtre *parametre);
+static int applique_gris(PNM *image, const Parametre_filtre *parametre);
+static int applique_noir_blanc(PNM *image, const Parametre_filtre *parametre);
+static int applique_matrice(PNM *image, const Parametre_filtre *parametre);
+static int applique_teinte(PNM *image, const Parametre_filtre *parametre);
+static int applique_flou(PNM *image, const Parametre_filtre *parametre);
+static int applique_sauvola(PNM *image, const Parametre_filtre *parametre);
+static int applique_bradley(PNM *image, const Parametre_filtre *parametre);
+static int applique_median(PNM *image, const Parametre_filtre *parametre);
+static int applique_erosion(PNM *image, const Parametre_filtre *parametre);
+static int applique_dilatation(PNM *image, const Parametre_filtre *parametre);
+static int applique_ouverture(PNM *image, const Parametre_filtre *parametre);
+static int applique_fermeture(PNM *image, const Parametre_filtre *parametre);
+static int applique_egalisation(PNM *image, const Parametre_filtre *parametre);
+static int applique_clahe(PNM *image, const Parametre_filtre *parametre);
+static int applique_quantification(PNM *image, const Parametre_filtre *parametre);
+static int applique_bilateral(PNM *image, const Parametre_filtre *parametre);
+static int halo_global(const Parametre_filtre *parametre);
+static int halo_noir_blanc(const Parametre_filtre *parametre);
+static int halo_rayon(const Parametre_filtre *parametre);
+static int halo_element_structurant(const Parametre_filtre *parametre);
+static unsigned long long memoire_une_integrale(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_deux_integrales(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_median(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_morphologie(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_egalisation(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_clahe(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_quantification(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+static unsigned long long memoire_bilateral(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+
+/**
+ * Registre des filtres, terminé par un descripteur de nom NULL
+ * 
+ */
+static const Descripteur_filtre registre[] = {
+    {"retournement", 0, NULL, NULL, applique_retournement, halo_global, NULL, 1},
+    {"miroir_horizontal", 0, NULL, NULL, applique_miroir_horizontal, NULL, NULL, 0},
+    {"miroir_vertical", 0, NULL, NULL, applique_miroir_vertical, halo_global, NULL, 1},
+    {"monochrome", 1, lit_couleur, valide_ppm, applique_monochrome, NULL, NULL, 0},
+    {"negatif", 0, NULL, valide_ppm, applique_negatif, NULL, NULL, 0},
+    {"gris", 1, lit_technique, valide_ppm, applique_gris, NULL, NULL, 0},
+    {"NB", 1, lit_seuil, valide_seuil, applique_noir_blanc, halo_noir_blanc, NULL, 0},
+    {"matrice", 1, lit_matrice, valide_ppm, applique_matrice, NULL, NULL, 0},
+    {"teinte", 1, lit_teinte, valide_ppm, applique_teinte, NULL, NULL, 0},
+    {"flou", 1, lit_rayon, valide_gris, applique_flou, halo_rayon, memoire_une_integrale, 0},
+    {"sauvola", 1, lit_rayon_sauvola, valide_gris, applique_sauvola, halo_rayon, memoire_deux_integrales, 0},
+    {"bradley", 1, lit_rayon_bradley, valide_gris, applique_bradley, halo_rayon, memoire_une_integrale, 0},
+    {"median", 1, lit_rayon_median, valide_gris, applique_median, halo_rayon, memoire_median, 0},
+    {"erosion", 1, lit_element_structurant, valide_pbm, applique_erosion, halo_element_structurant, memoire_morphologie, 0},
+    {"dilatation", 1, lit_element_structurant, valide_pbm, applique_dilatation, halo_element_structurant, memoire_morphologie, 0},
+    {"ouverture", 1, lit_element_structurant, valide_pbm, applique_ouverture, halo_element_structurant, memoire_morphologie, 0},
+    {"fermeture", 1, lit_element_structurant, valide_pbm, applique_fermeture, halo_element_structurant, memoire_morphologie, 0},
+    {"egalisation", 0, NULL, valide_gris, applique_egalisation, halo_global, memoire_egalisation, 0},
+    {"clahe", 0, lit_clahe, valide_gris, applique_clahe, halo_global, memoire_clahe, 0},
+    {"quantification", 1, lit_quantification, valide_ppm, applique_quantification, halo_global, memoire_quantification, 0},
+    {"bilateral", 1, lit_bilateral, valide_gris, applique_bilateral, halo_global, memoire_bilateral, 0},
+    {NULL, 0, NULL, NULL, NULL, NULL, NULL, 0}
+};
+
+
+const Descripteur_filtre *cherche_filtre(const char *nom){
+    assert(nom!=NULL);
+
+    for(int i=0; registre[i].nom!=NULL; i++){
+        if(strcmp(registre[i].nom, nom)==0)
+            return &registre[i];
+    }
+
+    return NULL;
+}
+
+int prepare_filtre(Filtre_prepare *filtre, const char *nom, const char *parametre){
+    assert(filtre!=NULL && nom!=NULL);
+
+    filtre->descripteur = cherche_filtre(nom);
+    if(filtre->descripteur==NULL)
+        return -1;
+    memset(&filtre->parametre, 0, sizeof(Parametre_filtre));
+
+    //un paramètre donné à un filtre qui n'en prend pas est refusé plutôt qu'ignoré (il entrerait dans la clé du cache)
+    if(filtre->descripteur->lit_parametre==NULL)
+        return (parametre!=NULL) ? -3 : 0;
+    if(parametre==NULL)
+        return filtre->descripteur->parametre_requis ? -2 : 0;
+    if(filtre->descripteur->lit_parametre(parametre, &filtre->parametre)==-1)
+        return -3;
+
+    return 0;
+}
+
+int applique_filtre(const Filtre_prepare *filtre, PNM *image){
+    assert(filtre!=NULL && filtre->descripteur!=NULL && image!=NULL);
+    unsigned long long trace = debut_trace();
+
+    if(filtre->descripteur->valide!=NULL && filtre->descripteur->valide(&filtre->parametre, image)==-1)
+        return -1;
+    if(filtre->descripteur->applique(image, &filtre->parametre)!=0)
+        return -1;
+
+    fin_trace(filtre->descripteur->nom, trace);
+    return 0;
+}
+
+static int lit_entier(const char *texte, long min, long max, long *valeur){
+    char *fin;
+
+    errno = 0;
+    *valeur = strtol(texte, &fin, 10);
+    if(fin==texte || *fin!='\0' || errno!=0 || *valeur<min || *valeur>max)
+        return -1;
+
+    return 0;
+}
+
+static int lit_couleur(const char *texte, Parametre_filtre *parametre){
+    if((texte[0]!='r' && texte[0]!='v' && texte[0]!='b') || texte[1]!='\0')
+        return -1;
+    parametre->couleur = texte[0];
+
+    return 0;
+}
+
+static int lit_technique(const char *texte, Parametre_filtre *parametre){
+    long technique;
+
+    if(lit_entier(texte, 1, 2, &technique)==-1)
+        return -1;
+    parametre->technique = (int)technique;
+
+    return 0;
+}
+
+static int lit_seuil(const char *texte, Parametre_filtre *parametre){
+    char seuil_texte[16];
+    const char *virgule = strchr(texte, ',');
+    long seuil;
+
+    //forme "seuil" ou "seuil,tramage"
+    if(virgule==NULL)
+        virgule = texte + strlen(texte);
+    if(virgule-texte >= (long)sizeof(seuil_texte))
+        return -1;
+    memcpy(seuil_texte, texte, virgule-texte);
+    seuil_texte[virgule-texte] = '\0';
+
+    if(lit_entier(seuil_texte, 0, 65535, &seuil)==-1)
+        return -1;
+    parametre->seuil = (unsigned int)seuil;
+
+    if(*virgule=='\0' || strcmp(virgule+1, "seuil")==0)
+        parametre->tramage = tramage_aucun;
+    else if(strcmp(virgule+1, "fs")==0)
+        parametre->tramage = tramage_floyd_steinberg;
+    else if(strcmp(virgule+1, "atkinson")==0)
+        parametre->tramage = tramage_atkinson;
+    else if(strcmp(virgule+1, "bayer")==0)
+        parametre->tramage = tramage_bayer;
+    else
+        return -1;
+
+    return 0;
+}
+
+static int lit_matrice(const char *texte, Parametre_filtre *parametre){
+    const char *position = texte;
+    char *fin;
+
+    //nom d'une transformation prédéfinie, ou 12 coefficients séparés par des virgules
+    if(matrice_couleur_predefinie(&parametre->matrice, texte)==0)
+        return 0;
+
+    for(int i=0; i<12; i++){
+        parametre->matrice.coefficients[i/4][i%4] = strtod(position, &fin);
+        if(fin==position || (i<11 && *fin!=',') || (i==11 && *fin!='\0'))
+            return -1;
+        position = fin + 1;
+    }
+
+    //nan, inf ou coefficient trop grand: la virgule fixe déborderait
+    return verifie_matrice_couleur(&parametre->matrice);
+}
+
+static int lit_teinte(const char *texte, Parametre_filtre *parametre){
+    char *fin;
+
+    //forme "teinte" ou "teinte,saturation"
+    parametre->teinte = strtod(texte, &fin);
+    if(fin==texte)
+        return -1;
+    parametre->saturation = 1.0;
+    if(*fin==','){
+        texte = fin + 1;
+        parametre->saturation = strtod(texte, &fin);
+        if(fin==texte)
+            return -1;
+    }
+    if(*fin!='\0')
+        return -1;
+
+    //nan ou inf: le secteur de teinte calculé à partir de la teinte serait indéfini
+    return verifie_teinte_saturation(parametre->teinte, parametre->saturation);
+}
+
+static int lit_rayon_reel(const char *texte, double defaut, Parametre_filtre *parametre){
+    char rayon_texte[16], *fin;
+    const char *virgule = strchr(texte, ',');
+    long rayon;
+
+    //forme "rayon" ou "rayon,k"
+    if(virgule==NULL)
+        virgule = texte + strlen(texte);
+    if(virgule-texte >= (long)sizeof(rayon_texte))
+        return -1;
+    memcpy(rayon_texte, texte, virgule-texte);
+    rayon_texte[virgule-texte] = '\0';
+
+    if(lit_entier(rayon_texte, 0, 1 << 20, &rayon)==-1)
+        return -1;
+    parametre->rayon = (int)rayon;
+
+    parametre->k = defaut;
+    if(*virgule==','){
+        parametre->k = strtod(virgule+1, &fin);
+        //nan rendrait chaque seuil indéfini, et l'image entièrement noire
+        if(fin==virgule+1 || *fin!='\0' || !isfinite(parametre->k) || parametre->k<0 || parametre->k>K_MAX_SEUILLAGE)
+            return -1;
+    }
+
+    return 0;
+}
+
+static int lit_rayon(const char *texte, Parametre_filtre *parametre){
+    if(strchr(texte, ',')!=NULL)
+        return -1;
+    return lit_rayon_reel(texte, 0, parametre);
+}
+
+static int lit_rayon_sauvola(const char *texte, Parametre_filtre *parametre){
+    return lit_rayon_reel(texte, 0.2, parametre);
+}
+
+static int lit_rayon_bradley(const char *texte, Parametre_filtre *parametre){
+    return lit_rayon_reel(texte, 0.15, parametre);
+}
+
+static int lit_rayon_median(const char *texte, Parametre_filtre *parametre){
+    if(lit_rayon(texte, parametre)==-1 || parametre->rayon>32767)
+        return -1;
+    return 0;
+}
+
+static int lit_element_structurant(const char *texte, Parametre_filtre *parametre){
+    long largeur, hauteur;
+    char largeur_texte[16];
+    const char *virgule = strchr(texte, ',');
+
+    //forme "largeur" (carré) ou "largeur,hauteur"
+    if(virgule==NULL)
+        virgule = texte + strlen(texte);
+    if(virgule-texte >= (long)sizeof(largeur_texte))
+        return -1;
+    memcpy(largeur_texte, texte, virgule-texte);
+    largeur_texte[virgule-texte] = '\0';
+
+    if(lit_entier(largeur_texte, 1, 1 << 20, &largeur)==-1)
+        return -1;
+    hauteur = largeur;
+    if(*virgule==',' && lit_entier(virgule+1, 1, 1 << 20, &hauteur)==-1)
+        return -1;
+    parametre->largeur = (int)largeur;
+    parametre->hauteur = (int)hauteur;
+
+    return 0;
+}
+
+static int lit_clahe(const char *texte, Parametre_filtre *parametre){
+    char tuiles_texte[16], *fin;
+    const char *virgule = strchr(texte, ',');
+    long nbr_tuiles;
+
+    //forme "tuiles" ou "tuiles,limite"
+    if(virgule==NULL)
+        virgule = texte + strlen(texte);
+    if(virgule-texte >= (long)sizeof(tuiles_texte))
+        return -1;
+    memcpy(tuiles_texte, texte, virgule-texte);
+    tuiles_texte[virgule-texte] = '\0';
+
+    if(lit_entier(tuiles_texte, 1, 256, &nbr_tuiles)==-1)
+        return -1;
+    parametre->nbr_tuiles = (int)nbr_tuiles;
+
+    parametre->limite = LIMITE_CLAHE;
+    if(*virgule==','){
+        parametre->limite = strtod(virgule+1, &fin);
+        //inf ou nan: la hauteur maximale d'une classe, convertie en entier, serait indéfinie
+        if(fin==virgule+1 || *fin!='\0' || !isfinite(parametre->limite) || parametre->limite<1 || parametre->limite>LIMITE_MAX_CLAHE)
+            return -1;
+    }
+
+    return 0;
+}
+
+static int lit_quantification(const char *texte, Parametre_filtre *parametre){
+    char couleurs_texte[16];
+    const char *virgule = strchr(texte, ','), *option, *fin;
+    long nbr_couleurs;
+
+    //forme "couleurs" suivie de ",median" ou ",kmoyennes" et de ",fs", dans cet ordre
+    if(virgule==NULL)
+        virgule = texte + strlen(texte);
+    if(virgule-texte >= (long)sizeof(couleurs_texte))
+        return -1;
+    memcpy(couleurs_texte, texte, virgule-texte);
+    couleurs_texte[virgule-texte] = '\0';
+
+    if(lit_entier(couleurs_texte, 2, NBR_MAX_COULEURS, &nbr_couleurs)==-1)
+        return -1;
+    parametre->nbr_couleurs = (int)nbr_couleurs;
+    parametre->methode = quantification_coupe_mediane;
+    parametre->tramage = tramage_aucun;
+
+    for(option=virgule; *option==','; option=fin){
+        option++;
+        fin = strchr(option, ',');
+        if(fin==NULL)
+            fin = option + strlen(option);
+        if(fin-option==6 && strncmp(option, "median", 6)==0 && option==virgule+1)
+            parametre->methode = quantification_coupe_mediane;
+        else if(fin-option==9 && strncmp(option, "kmoyennes", 9)==0 && option==virgule+1)
+            parametre->methode = quantification_kmoyennes;
+        else if(fin-option==2 && strncmp(option, "fs", 2)==0 && *fin=='\0')
+            parametre->tramage = tramage_floyd_steinberg;
+        else
+            return -1;
+    }
+
+    return 0;
+}
+
+static int lit_bilateral(const char *texte, Parametre_filtre *parametre){
+    char *fin;
+
+    //forme "sigma_spatial" ou "sigma_spatial,sigma_intensite"
+    parametre->sigma_spatial = strtod(texte, &fin);
+    if(fin==texte || !(parametre->sigma_spatial>=1 && parametre->sigma_spatial<=(1 << 20)))
+        return -1;
+    parametre->sigma_intensite = 0;
+    if(*fin==','){
+        texte = fin + 1;
+        parametre->sigma_intensite = strtod(texte, &fin);
+        if(fin==texte || !(parametre->sigma_intensite>0 && parametre->sigma_intensite<=65535))
+            return -1;
+    }
+
+    return (*fin=='\0') ? 0 : -1;
+}
+
+static int valide_gris(const Parametre_filtre *parametre, PNM *image){
+    (void)parametre;
+    if(acces_format_PNM(image)==1){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PGM ou PPM pour pouvoir y appliquer ce filtre.\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int valide_ppm(const Parametre_filtre *parametre, PNM *image){
+    (void)parametre;
+    if(acces_format_PNM(image)!=3){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PPM pour pouvoir y appliquer ce filtre.\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int valide_seuil(const Parametre_filtre *parametre, PNM *image){
+    if(acces_format_PNM(image)==1){
+        printf("L'image donnée est déjà en noir et blanc.\n");
+        return -1;
+    }
+    if(parametre->seuil>acces_valeur_max_PNM(image)){
+        printf("Le seuil entré n'est pas une valeur de seuil valable.\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int valide_pbm(const Parametre_filtre *parametre, PNM *image){
+    (void)parametre;
+    if(acces_format_PNM(image)!=1){
+        printf("Mauvais format d'image. Le fichier donné doit être une image au format PBM pour pouvoir y appliquer ce filtre.\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int applique_retournement(PNM *image, const Parametre_filtre *parametre){
+    (void)parametre;
+    retournement(image);
+
+    return 0;
+}
+
+static int applique_miroir_horizontal(PNM *image, const Parametre_filtre *parametre){
+    (void)parametre;
+    miroir_horizontal(image);
+
+    return 0;
+}
+
+static int applique_miroir_vertical(PNM *image, const Parametre_filtre *parametre){
+    (void)parametre;
+    miroir_vertical(image);
+
+    return 0;
+}
+
+static int applique_monochrome(PNM *image, const Parametre_filtre *parametre){
+    return monochrome_couleur(image, parametre->couleur);
+}
+
+static int applique_negatif(PNM *image, const Parametre_filtre *parametre){
+    (void)parametre;
+    return negatif(image);
+}
+
+static int applique_gris(PNM *image, const Parametre_filtre *parametre){
+    return gris_technique(image, parametre->technique);
+}
+
+static int applique_noir_blanc(PNM *image, const Parametre_filtre *parametre){
+    return noir_blanc_tramage(image, parametre->seuil, parametre->tramage);
+}
+
+static int applique_matrice(PNM *image, const Parametre_filtre *parametre){
+    return applique_matrice_couleur(image, &parametre->matrice);
+}
+
+static int applique_teinte(PNM *image, const Parametre_filtre *parametre){
+    return ajuste_teinte_saturation(image, parametre->teinte, parametre->saturation);
+}
+
+static int applique_flou(PNM *image, const Parametre_filtre *parametre){
+    return flou_boite(image, parametre->rayon);
+}
+
+static int applique_sauvola(PNM *image, const Parametre_filtre *parametre){
+    return seuillage_adaptatif(image, parametre->rayon, parametre->k, sauvola);
+}
+
+static int applique_bradley(PNM *image, const Parametre_filtre *parametre){
+    return seuillage_adaptatif(image, parametre->rayon, parametre->k, bradley);
+}
+
+static int applique_median(PNM *image, const Parametre_filtre *parametre){
+    return median(image, parametre->rayon);
+}
+
+static int applique_erosion(PNM *image, const Parametre_filtre *parametre){
+    return morphologie(image, erosion, parametre->largeur, parametre->hauteur);
+}
+
+static int applique_dilatation(PNM *image, const Parametre_filtre *parametre){
+    return morphologie(image, dilatation, parametre->largeur, parametre->hauteur);
+}
+
+static int applique_ouverture(PNM *image, const Parametre_filtre *parametre){
+    return morphologie(image, ouverture, parametre->largeur, parametre->hauteur);
+}
+
+static int applique_fermeture(PNM *image, const Parametre_filtre *parametre){
+    return morphologie(image, fermeture, parametre->largeur, parametre->hauteur);
+}
+
+static int applique_egalisation(PNM *image, const Parametre_filtre *parametre){
+    (void)parametre;
+    return egalisation_histogramme(image);
+}
+
+static int applique_clahe(PNM *image, const Parametre_filtre *parametre){
+    //sans paramètre, nbr_tuiles et limite sont restés nuls
+    if(parametre->nbr_tuiles==0)
+        return clahe(image, NBR_TUILES_CLAHE, LIMITE_CLAHE);
+    return clahe(image, parametre->nbr_tuiles, parametre->limite);
+}
+
+static int applique_quantification(PNM *image, const Parametre_filtre *parametre){
+    return quantification(image, parametre->nbr_couleurs, parametre->methode, parametre->tramage);
+}
+
+static int applique_bilateral(PNM *image, const Parametre_filtre *parametre){
+    return filtre_bilateral(image, parametre->sigma_spatial, parametre->sigma_intensite);
+}
+
+static int halo_global(const Parametre_filtre *parametre){
+    (void)parametre;
+    //retournement, miroir vertical: chaque ligne résultat dépend de la ligne symétrique; égalisation, quantification: histogramme de toute l'image;
+    //bilatéral: la grille est alignée sur la première ligne de l'image
+    return -1;
+}
+
+static int halo_noir_blanc(const Parametre_filtre *parametre){
+    //la diffusion d'erreur propage l'erreur de chaque ligne à toutes les suivantes
+    if(parametre->tramage==tramage_floyd_steinberg || parametre->tramage==tramage_atkinson)
+        return -1;
+    return 0;
+}
+
+static int halo_rayon(const Parametre_filtre *parametre){
+    return parametre->rayon;
+}
+
+static int halo_element_structurant(const Parametre_filtre *parametre){
+    //ouverture et fermeture enchaînent deux passes de portée au plus hauteur-1 au total
+    return parametre->hauteur;
+}
+
+static unsigned long long memoire_une_integrale(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    (void)parametre;
+    return (unsigned long long)(nbr_ligne+1) * (entete->nbr_colonne+1) * sizeof(unsigned long long);
+}
+
+static unsigned long long memoire_deux_integrales(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    return 2 * memoire_une_integrale(parametre, entete, nbr_ligne);
+}
+
+static unsigned long long memoire_median(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    unsigned long long nbr_classes = entete->valeur_max + 1, nbr_threads = nombre_threads_disponibles();
+
+    //copie d'une composante, puis histogrammes de colonne de chaque bande verticale et de sa marge
+    return (unsigned long long)nbr_ligne * entete->nbr_colonne * sizeof(unsigned short)
+           + (entete->nbr_colonne + 2ULL * parametre->rayon * nbr_threads) * nbr_classes * sizeof(unsigned short)
+           + nbr_threads * nbr_classes * sizeof(unsigned int);
+}
+
+static unsigned long long memoire_morphologie(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    unsigned long long nbr_mots = (entete->nbr_colonne + 63) / 64;
+
+    //image compactée, puis préfixes et suffixes de van Herk / Gil-Werman
+    return (unsigned long long)nbr_ligne * nbr_mots * 8
+           + ((unsigned long long)nbr_ligne + 3ULL * parametre->hauteur) * nbr_mots * 2 * 8;
+}
+
+static unsigned long long memoire_egalisation(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    unsigned long long nbr_classes = entete->valeur_max + 1ULL;
+    (void)parametre;
+    (void)nbr_ligne;
+
+    //un histogramme par bande de lignes, une table de correspondance
+    return nombre_threads_disponibles() * nbr_classes * sizeof(unsigned int) + nbr_classes * sizeof(unsigned short);
+}
+
+static unsigned long long memoire_clahe(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    unsigned long long nbr_classes = entete->valeur_max + 1ULL;
+    unsigned long long nbr_tuiles = (parametre->nbr_tuiles>0) ? parametre->nbr_tuiles : NBR_TUILES_CLAHE;
+    (void)nbr_ligne;
+
+    //histogramme et table de chaque tuile, position de chaque colonne
+    return nbr_tuiles * nbr_tuiles * nbr_classes * (sizeof(unsigned int) + sizeof(unsigned short))
+           + entete->nbr_colonne * (sizeof(int) + sizeof(double));
+}
+
+static unsigned long long memoire_quantification(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    unsigned long long nbr_cases = 1ULL << (3*BITS_CUBE_QUANTIFICATION);
+    (void)parametre;
+    (void)nbr_ligne;
+
+    //un cube par bande de lignes, la table inverse, les erreurs diffusées sur deux lignes
+    return nombre_threads_disponibles() * nbr_cases * sizeof(unsigned int) + nbr_cases
+           + (entete->valeur_max + 1ULL) + 6ULL * (entete->nbr_colonne + 2) * sizeof(long);
+}
+
+static unsigned long long memoire_bilateral(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne){
+    double sigma_intensite = (parametre->sigma_intensite>0) ? parametre->sigma_intensite : SIGMA_INTENSITE_BILATERAL * entete->valeur_max;
+    unsigned long long largeur, hauteur, profondeur;
+
+    if(sigma_intensite < 1)
+        sigma_intensite = 1;
+    largeur = (unsigned long long)(entete->nbr_colonne / parametre->sigma_spatial) + 2 + 2*MARGE_GRILLE_BILATERALE;
+    hauteur = (unsigned long long)(nbr_ligne / parametre->sigma_spatial) + 2 + 2*MARGE_GRILLE_BILATERALE;
+    profondeur = (unsigned long long)(entete->valeur_max / sigma_intensite) + 2 + 2*MARGE_GRILLE_BILATERALE;
+
+    //la grille et le tampon de ses flous: sommes des composantes et nombre de pixels par case
+    return 2 * largeur * hauteur * profondeur * ((entete->format==3) ? 4 : 2) * sizeof(float);
+}
@@ -0,0 +1,127 @@
+/**
+ * \file registre.h
+ * \brief Ce fichier contient les déclarations de types et les prototypes des fonctions du registre de filtres.
+ * 
+ * Chaque filtre est décrit par un descripteur: son nom, une fonction lisant
+ * une seule fois son paramètre textuel, une fonction de validation sur une
+ * image et la fonction appliquant le filtre. Un filtre préparé peut ensuite
+ * être appliqué à un nombre quelconque d'images sans manipulation de chaînes.
+ * 
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ * 
+ */
+
+//Include guard
+#ifndef __REGISTRE__
+#define __REGISTRE__
+
+#include "pnm.h"
+#include "couleur.h"
+
+/**
+ * \struct Parametre_filtre
+ * \brief Paramètre d'un filtre, lu une seule fois depuis sa forme textuelle
+ * 
+ */
+typedef struct {
+    char couleur;//monochrome: 'r', 'v' ou 'b'
+    int technique;//gris: 1 ou 2
+    unsigned int seuil;//noir et blanc
+    int tramage;//noir et blanc, quantification: valeur de l'enum Tramage
+    Matrice_couleur matrice;//matrice de couleur
+    double teinte, saturation;//ajustement de teinte (degrés) et de saturation (facteur)
+    int rayon;//filtres par fenêtre
+    double k;//seuillage adaptatif
+    int largeur, hauteur;//élément structurant des opérations morphologiques
+    int nbr_tuiles;//CLAHE: tuiles par ligne et par colonne
+    double limite;//CLAHE: écrêtage, en multiple de la hauteur moyenne d'une classe
+    int nbr_couleurs;//quantification: taille de la palette
+    int methode;//quantification: valeur de l'enum Methode_quantification
+    double sigma_spatial, sigma_intensite;//filtre bilatéral (pixels, niveaux; sigma_intensite 0: défaut)
+} Parametre_filtre;
+
+/**
+ * \struct Descripteur_filtre
+ * \brief Description d'un filtre du registre
+ * 
+ */
+typedef struct {
+    const char *nom;
+    int parametre_requis;//1 si le filtre nécessite un paramètre
+    int (*lit_parametre)(const char *texte, Parametre_filtre *parametre);
+    int (*valide)(const Parametre_filtre *parametre, PNM *image);
+    int (*applique)(PNM *image, const Parametre_filtre *parametre);
+    //lignes voisines dont dépend une ligne résultat, -1 si le filtre a besoin de l'image entière (NULL: 0)
+    int (*halo)(const Parametre_filtre *parametre);
+    //mémoire de travail, en octets, du filtre sur nbr_ligne lignes de l'image décrite par entete (NULL: 0)
+    unsigned long long (*memoire_travail)(const Parametre_filtre *parametre, const Entete_PNM *entete, int nbr_ligne);
+    //1 si, appliqué à une bande, le filtre en écrit les lignes dans l'ordre inverse, chacune ne dépendant que de sa ligne symétrique
+    int lignes_inversees;
+} Descripteur_filtre;
+
+/**
+ * \struct Filtre_prepare
+ * \brief Un filtre du registre et son paramètre déjà lu
+ * 
+ */
+typedef struct {
+    const Descripteur_filtre *descripteur;
+    Parametre_filtre parametre;
+} Filtre_prepare;
+
+/**
+ * \fn *cherche_filtre(const char *nom)
+ * \brief Cherche un filtre dans le registre à partir de son nom
+ * 
+ * \param nom chaine de caractère contenant le nom du filtre
+ * 
+ * \pre nom!=NULL
+ * \post /
+ * 
+ * \return
+ *      NULL si aucun filtre ne porte ce nom \n
+ *      un pointeur sur le descripteur du filtre sinon
+ * 
+ */
+const Descripteur_filtre *cherche_filtre(const char *nom);
+
+/**
+ * \fn prepare_filtre(Filtre_prepare *filtre, const char *nom, const char *parametre)
+ * \brief Prépare un filtre du registre: recherche du descripteur et lecture du paramètre
+ * 
+ * \param filtre pointeur sur Filtre_prepare à remplir
+ * \param nom chaine de caractère contenant le nom du filtre
+ * \param parametre chaine de caractère contenant le paramètre du filtre, 
+ * NULL si aucun paramètre n'est donné
+ * 
+ * \pre filtre!=NULL, nom!=NULL
+ * \post filtre peut être appliqué avec applique_filtre
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Aucun filtre ne porte ce nom \n
+ *      -2 Paramètre nécessaire manquant \n
+ *      -3 Paramètre incorrect, ou donné à un filtre sans paramètre
+ * 
+ */
+int prepare_filtre(Filtre_prepare *filtre, const char *nom, const char *parametre);
+
+/**
+ * \fn applique_filtre(const Filtre_prepare *filtre, PNM *image)
+ * \brief Valide un filtre préparé pour image, puis l'applique
+ * 
+ * \param filtre pointeur sur Filtre_prepare, préparé par prepare_filtre
+ * \param image pointeur sur PNM auquel appliquer le filtre
+ * 
+ * \pre filtre!=NULL, image!=NULL
+ * \post le filtre a été appliqué sur image
+ * 
+ * \return
+ *       0 Succès \n
+ *      -1 Le filtre ne peut être appliqué sur image
+ * 
+ */
+int applique_filtre(const Filtre_prepare *filtre, PNM *image);
+
+#endif
@@ -0,0 +1,181 @@
+/**
+ * \file trace.c
+ * \brief Ce fichier contient l'enregistrement de traces d'exécution et leur export au format Chrome / Perfetto.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "trace.h"
+
+/**
+ * \struct Intervalle
+ * \brief Intervalle enregistré, en nanosecondes depuis l'activation
+ */
+typedef struct {
+    const char *nom;
+    unsigned long long debut, duree;
+} Intervalle;
+
+/**
+ * \struct Tampon_trace
+ * \brief Tampon circulaire d'un thread; nbr_intervalles n'est modifié que par ce thread
+ */
+typedef struct Tampon_trace {
+    Intervalle intervalles[CAPACITE_TRACE];
+    unsigned long long nbr_intervalles;
+    int numero;//piste du tampon dans la trace exportée
+    struct Tampon_trace *suivant;//liste de tous les tampons
+    struct Tampon_trace *suivant_libre;//liste des tampons des threads terminés
+} Tampon_trace;
+
+/**
+ * État global des traces, initialisé par active_trace avant la création de tout thread
+ */
+static int trace_active = 0;
+static const char *fichier_trace = NULL;
+static unsigned long long origine_trace;
+static pthread_key_t cle_tampon;
+static pthread_mutex_t verrou_tampons = PTHREAD_MUTEX_INITIALIZER;
+static Tampon_trace *tampons = NULL, *tampons_libres = NULL;
+static int nbr_tampons = 0;
+
+/**
+ * Déclaration des fonctions statiques
+ *
+ */
+static unsigned long long maintenant(void);
+static Tampon_trace *tampon_courant(void);
+static void rend_tampon(void *tampon);
+static void exporte_a_la_sortie(void);
+
+
+int active_trace(const char *filename){
+    assert(filename!=NULL);
+
+    if(trace_active){
+        fichier_trace = filename;
+        return 0;
+    }
+    if(pthread_key_create(&cle_tampon, rend_tampon)!=0)
+        return -1;
+    if(atexit(exporte_a_la_sortie)!=0){
+        pthread_key_delete(cle_tampon);
+        return -1;
+    }
+    fichier_trace = filename;
+    origine_trace = maintenant();
+    trace_active = 1;
+
+    return 0;
+}
+
+unsigned long long debut_trace(void){
+    return trace_active ? maintenant() : 0;
+}
+
+void fin_trace(const char *nom, unsigned long long debut){
+    assert(nom!=NULL);
+    Tampon_trace *tampon;
+    Intervalle *intervalle;
+    unsigned long long fin;
+
+    if(!trace_active || debut==0)
+        return;
+    fin = maintenant();
+    tampon = tampon_courant();
+    if(tampon==NULL)
+        return;
+
+    intervalle = &tampon->intervalles[tampon->nbr_intervalles % CAPACITE_TRACE];
+    intervalle->nom = nom;
+    intervalle->debut = debut - origine_trace;
+    intervalle->duree = fin - debut;
+    tampon->nbr_intervalles++;
+}
+
+int exporte_trace(const char *filename){
+    assert(filename!=NULL);
+    FILE *fichier;
+    Intervalle *intervalle;
+    unsigned long long premier;
+    int premier_evenement = 1;
+
+    fichier = fopen(filename, "w");
+    if(fichier==NULL)
+        return -1;
+
+    //une piste nommée par tampon, puis ses intervalles complets (ph "X", temps en microsecondes)
+    fprintf(fichier, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    for(Tampon_trace *tampon=tampons; tampon!=NULL; tampon=tampon->suivant){
+        fprintf(fichier, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"thread %d\"}}",
+                premier_evenement ? "" : ",\n", tampon->numero, tampon->numero);
+        premier_evenement = 0;
+
+        premier = (tampon->nbr_intervalles > CAPACITE_TRACE) ? tampon->nbr_intervalles - CAPACITE_TRACE : 0;
+        for(unsigned long long k=premier; k<tampon->nbr_intervalles; k++){
+            intervalle = &tampon->intervalles[k % CAPACITE_TRACE];
+            fprintf(fichier, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    intervalle->nom, tampon->numero, intervalle->debut / 1000.0, intervalle->duree / 1000.0);
+        }
+    }
+    fprintf(fichier, "\n]}\n");
+
+    return (fclose(fichier)==0) ? 0 : -1;
+}
+
+static unsigned long long maintenant(void){
+    struct timespec temps;
+
+    clock_gettime(CLOCK_MONOTONIC, &temps);
+    return (unsigned long long)temps.tv_sec * 1000000000ULL + temps.tv_nsec;
+}
+
+static Tampon_trace *tampon_courant(void){
+    Tampon_trace *tampon = pthread_getspecific(cle_tampon);
+
+    if(tampon!=NULL)
+        return tampon;
+
+    //premier intervalle du thread: tampon d'un thread terminé, sinon nouveau tampon
+    pthread_mutex_lock(&verrou_tampons);
+    if(tampons_libres!=NULL){
+        tampon = tampons_libres;
+        tampons_libres = tampon->suivant_libre;
+    }
+    else{
+        tampon = malloc(sizeof(Tampon_trace));
+        if(tampon!=NULL){
+            tampon->nbr_intervalles = 0;
+            tampon->numero = nbr_tampons++;
+            tampon->suivant = tampons;
+            tampons = tampon;
+        }
+    }
+    pthread_mutex_unlock(&verrou_tampons);
+
+    if(tampon!=NULL)
+        pthread_setspecific(cle_tampon, tampon);
+    return tampon;
+}
+
+static void rend_tampon(void *tampon){
+    pthread_mutex_lock(&verrou_tampons);
+    ((Tampon_trace *)tampon)->suivant_libre = tampons_libres;
+    tampons_libres = tampon;
+    pthread_mutex_unlock(&verrou_tampons);
+}
+
+static void exporte_a_la_sortie(void){
+    if(exporte_trace(fichier_trace)!=0)
+        printf("Les traces n'ont pas pu être écrites dans %s.\n", fichier_trace);
+}
@@ -0,0 +1,79 @@
+/**
+ * \file trace.h
+ * \brief Ce fichier contient les prototypes de l'enregistrement de traces d'exécution au format Chrome / Perfetto.
+ *
+ * Chaque thread écrit ses intervalles (nom, début, durée) dans son propre
+ * tampon circulaire, sans verrou: seul l'attribution d'un tampon à un
+ * nouveau thread en prend un. Le tampon d'un thread terminé est repris par le
+ * prochain thread créé, qui apparaît donc sur la même piste. Les traces sont
+ * exportées en JSON (format "trace event", lisible par chrome://tracing et
+ * Perfetto) à la fin du programme.
+ *
+ * \author: Russe Cyril s170220
+ * \date: 19-10-2026
+ *
+ */
+
+//Include guard
+#ifndef __TRACE__
+#define __TRACE__
+
+/**
+ * Nombre d'intervalles conservés par thread: au-delà, les plus anciens sont remplacés
+ */
+#define CAPACITE_TRACE 16384
+
+/**
+ * \fn active_trace(const char *filename)
+ * \brief Active l'enregistrement des traces, exportées dans filename à la sortie du programme
+ *
+ * \param filename le fichier JSON à écrire, qui doit rester valable jusqu'à la sortie
+ *
+ * \pre filename!=NULL, appelée avant la création de tout thread
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 L'export à la sortie ne peut être enregistré
+ *
+ */
+int active_trace(const char *filename);
+
+/**
+ * \fn debut_trace(void)
+ * \brief Donne l'instant de début d'un intervalle
+ *
+ * \return
+ *      l'instant en nanosecondes, 0 si les traces ne sont pas actives
+ *
+ */
+unsigned long long debut_trace(void);
+
+/**
+ * \fn fin_trace(const char *nom, unsigned long long debut)
+ * \brief Enregistre l'intervalle [debut, maintenant] dans le tampon du thread appelant
+ *
+ * \param nom le nom de l'intervalle, une chaîne qui doit rester valable jusqu'à l'export
+ * \param debut la valeur rendue par debut_trace au début de l'intervalle
+ *
+ * \pre nom!=NULL
+ * \post sans effet si les traces ne sont pas actives
+ *
+ */
+void fin_trace(const char *nom, unsigned long long debut);
+
+/**
+ * \fn exporte_trace(const char *filename)
+ * \brief Écrit les intervalles enregistrés par tous les threads au format JSON
+ *
+ * \param filename le fichier à écrire
+ *
+ * \pre filename!=NULL, aucun thread n'enregistre d'intervalle pendant l'export
+ *
+ * \return
+ *       0 Succès \n
+ *      -1 Écriture de filename impossible
+ *
+ */
+int exporte_trace(const char *filename);
+
+#endif